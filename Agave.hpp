@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------
 //	Agave.hpp.
 //	09/27/2022.				created.
-//	09/18/2024.				last modified.
+//	10/17/2026.				last modified.
 //--------------------------------------------------------------------
 //	*	Agave(TM) Coroutine Framework (based on ISO C++20 or later).
 //	*	if has any questions, 
@@ -41,6 +41,103 @@ namespace agave
 		details::__FGThread = fg_entry;
 	}
 
+	//--------------------------------------------------------------------
+	//	select the pending job queue of the job scheduler (the sorted list
+	//	by default, the timing wheel trades the precision for O(1) jobs),
+	//	must be called before the first 'co_await duration' to take effect.
+	//--------------------------------------------------------------------
+	inline bool set_job_backend(BJobBackend backend) noexcept
+	{
+		return details::BJobScheduler::select_backend(backend);
+	}
+
+	//--------------------------------------------------------------------
+	//	select the number of shards of the job scheduler, 0 for one per
+	//	hardware thread, takes effect the same way as the backend.
+	//--------------------------------------------------------------------
+	inline bool set_job_shards(unsigned count) noexcept
+	{
+		return details::BJobScheduler::select_shards(count);
+	}
+
+	//--------------------------------------------------------------------
+	//	select how the job scheduler waits for the deadlines, the timerfd
+	//	is precise to the microseconds (Linux only, returns false on the
+	//	other platforms), takes effect the same way as the backend.
+	//--------------------------------------------------------------------
+	inline bool set_job_timer(BJobTimer timer) noexcept
+	{
+		return details::BJobScheduler::select_timer(timer);
+	}
+
+	//--------------------------------------------------------------------
+	//	select how late a job may expire (the resolution of the timing
+	//	wheel, 1ms by default), takes effect the same way as the backend.
+	//--------------------------------------------------------------------
+	inline bool set_job_tolerance(details::BDuration tolerance) noexcept
+	{
+		return details::BJobScheduler::select_tolerance(tolerance);
+	}
+
+	//--------------------------------------------------------------------
+	//	select the longest backoff of polling an awaited std::future (1ms
+	//	by default, 50us at least), which bounds how late it resumes.
+	//--------------------------------------------------------------------
+	inline void set_future_backoff(details::BDuration backoff) noexcept
+	{
+		details::future_backoff_t::_max.store(
+			std::max(backoff, details::future_backoff_t::_min), std::memory_order::relaxed);
+	}
+
+
+	//--------------------------------------------------------------------
+	//	*** executors ***
+	//	* an executor has 'schedule()', an awaitable resuming on it, and
+	//	  'submit(std::coroutine_handle<>)', e.g. agave::ThreadPool.
+	//	* co_await agave::resume_on(ex) hops onto the executor 'ex'.
+	//--------------------------------------------------------------------
+	template <typename E>
+	concept Executor = details::executor<E>;
+
+	//--------------------------------------------------------------------
+	using ThreadPool = details::BThreadPool;
+
+	//--------------------------------------------------------------------
+	inline auto make_thread_pool(unsigned worker_count)
+	{
+		return details::BThreadPool::create(worker_count);
+	}
+
+	//--------------------------------------------------------------------
+	template <Executor E>
+	inline auto resume_on(E& ex)
+	{
+		return details::resume_on_t<decltype(ex.schedule())>{ {}, ex.schedule() };
+	}
+
+	//--------------------------------------------------------------------
+	//	run loop, e.g. for the main thread: set_fg_executor(loop) and then
+	//	loop.run() / loop.run_until(op) / loop.poll() on it.
+	//--------------------------------------------------------------------
+	using RunLoop = details::run_loop_t;
+
+	//--------------------------------------------------------------------
+	//	the executors of resume_background() / resume_foreground(), which
+	//	must outlive their use. they take precedence over the entries.
+	//--------------------------------------------------------------------
+	template <Executor E>
+	inline void set_bg_executor(E& ex) noexcept
+	{
+		details::__BGExecutor = ex;
+	}
+
+	//--------------------------------------------------------------------
+	template <Executor E>
+	inline void set_fg_executor(E& ex) noexcept
+	{
+		details::__FGExecutor = ex;
+	}
+
 
 	//--------------------------------------------------------------------
 	inline auto resume_background(void)
@@ -87,6 +184,114 @@ namespace agave
 	template <typename T, typename P>
 	using AsyncOperationWithProgress = details::async_operation_base_t<T, P>;
 
+    //--------------------------------------------------------------------
+    //  lazy, started only when awaited or by 'start()' / 'start_background()'.
+    //--------------------------------------------------------------------
+    template <typename T = void>
+    using Task = details::task_t<T>;
+
+    //--------------------------------------------------------------------
+    //  lazy stream of values: co_yield them, and pull them one by one by
+    //  'while (auto item = co_await gen.next())', in lockstep.
+    //--------------------------------------------------------------------
+    template <typename T>
+    using AsyncGenerator = details::async_generator_t<T>;
+
+
+	//--------------------------------------------------------------------
+	//	*** structured concurrency ***
+	//	* co_await agave::when_all(a, b, ...) resumes once all of them
+	//	  completed, with a tuple of their results.
+	//	* co_await agave::when_all(range) resumes with a vector of the
+	//	  results (nothing for the actions).
+	//	* co_await agave::when_any(...) resumes with the index of the first
+	//	  completed one, the others are cancelled.
+	//--------------------------------------------------------------------
+	template <details::joinable_async... Asyncs>
+	inline auto when_all(Asyncs const&... asyncs)
+	{
+		return details::when_all_t<Asyncs...>{ asyncs... };
+	}
+
+	//--------------------------------------------------------------------
+	template <std::ranges::input_range R>
+		requires details::joinable_async<std::ranges::range_value_t<R>>
+	inline auto when_all(R&& asyncs)
+	{
+		using Async = std::ranges::range_value_t<R>;
+		return details::when_all_range_t<Async>{ std::vector<Async>(std::ranges::begin(asyncs), std::ranges::end(asyncs)) };
+	}
+
+	//--------------------------------------------------------------------
+	template <details::joinable_async... Asyncs>
+	inline auto when_any(Asyncs const&... asyncs)
+	{
+		return details::when_any_t{ { details::join_access_t::data(asyncs)... } };
+	}
+
+	//--------------------------------------------------------------------
+	template <std::ranges::input_range R>
+		requires details::joinable_async<std::ranges::range_value_t<R>>
+	inline auto when_any(R&& asyncs)
+	{
+		std::vector<std::shared_ptr<details::async_action_data_t>> datas;
+		for (auto& async : asyncs)
+			datas.push_back(details::join_access_t::data(async));
+
+		return details::when_any_t{ std::move(datas) };
+	}
+
+
+	//--------------------------------------------------------------------
+	//	*** sleeps with slack ***
+	//	* co_await agave::sleep_for(30s, agave::slack(50ms)) may wake up to
+	//	  50ms late, the close sleeps are then woken up together.
+	//--------------------------------------------------------------------
+	inline auto slack(details::BDuration dur) noexcept
+	{
+		return details::slack_t{ dur };
+	}
+
+	//--------------------------------------------------------------------
+	inline auto sleep_for(details::BDuration dur, details::slack_t slack = {}) noexcept
+	{
+		return details::sleep_t{ details::BClock::now() + dur, slack._dur };
+	}
+
+	//--------------------------------------------------------------------
+	template <typename Clock, typename Duration>
+	inline auto sleep_until(std::chrono::time_point<Clock, Duration> tp, details::slack_t slack = {}) noexcept
+	{
+		return details::sleep_t{ details::to_job_time(tp), slack._dur };
+	}
+
+
+	//--------------------------------------------------------------------
+	//	*** deadlines ***
+	//	* co_await agave::with_timeout(op, 50ms) resumes with an
+	//	  Expected<T, Timeout>, holding either the result of 'op' or
+	//	  Timeout, 'op' is cancelled on timeout.
+	//--------------------------------------------------------------------
+	using Timeout = details::timeout_t;
+
+	//--------------------------------------------------------------------
+	template <typename T, typename E>
+	using Expected = details::expected_t<T, E>;
+
+	//--------------------------------------------------------------------
+	template <details::joinable_async Async, typename Clock, typename Duration>
+	inline auto with_deadline(Async const& async, std::chrono::time_point<Clock, Duration> deadline)
+	{
+		return details::timeout_awaiter_t<Async>{ async, details::sleep_until_async(details::to_job_time(deadline)) };
+	}
+
+	//--------------------------------------------------------------------
+	template <details::joinable_async Async>
+	inline auto with_timeout(Async const& async, details::BDuration timeout)
+	{
+		return with_deadline(async, details::BClock::now() + timeout);
+	}
+
 
     //--------------------------------------------------------------------
     //  *** types for progress reportering mechanism ***
@@ -98,6 +303,36 @@ namespace agave
     template <typename P>
     using ProgressController = details::progress_controller_t<P>;
 
+    //--------------------------------------------------------------------
+    using ProgressPolicy = details::progress_policy_t;
+
+
+	//--------------------------------------------------------------------
+	//	*** primitives suspending the coroutine instead of the thread ***
+	//	a canceled coroutine stops waiting: lock() resumes with a guard
+	//	not owning the mutex, acquire() / wait() resume with false.
+	//--------------------------------------------------------------------
+	using AsyncMutex = details::async_mutex_t;
+
+	//--------------------------------------------------------------------
+	using AsyncSemaphore = details::async_semaphore_t;
+
+	//--------------------------------------------------------------------
+	using AsyncLatch = details::async_latch_t;
+
+	//--------------------------------------------------------------------
+	using AsyncEvent = details::async_event_t;
+
+	//--------------------------------------------------------------------
+	//	agave::Channel<int> ch{ 256 };	// bounded, agave::Channel<int> ch; is unbounded.
+	//	co_await ch.send(42);			// false once closed.
+	//	auto v = co_await ch.receive();	// std::nullopt once closed and drained.
+	//	auto n = co_await ch.receive_many(span);
+	//	ch.close();
+	//--------------------------------------------------------------------
+	template <typename T>
+	using Channel = details::channel_t<T>;
+
 
 	//--------------------------------------------------------------------
 	//	*** token for cancellation ***
@@ -124,7 +359,7 @@ namespace agave
 		bool is_canceled(void) const noexcept
 		{
 			if (_promise)
-				return _promise->_async_data->_is_cancel.load(std::memory_order::acquire);
+				return _promise->_async_data->is_canceled();
             
 			return false;
 		}
@@ -157,6 +392,120 @@ namespace agave
 }
 
 
+//--------------------------------------------------------------------
+//	*** asynchronous file I/O over the io_uring of Linux ***
+//	* auto n = co_await agave::io::read(fd, buf, offset);	// the bytes, or -errno.
+//	* an offset of ~0 reads / writes at the file position.
+//	* the reactor starts on the first request, elsewhere the requests
+//	  resume with -ENOSYS at once.
+//--------------------------------------------------------------------
+namespace agave::io
+{
+	//--------------------------------------------------------------------
+	//	the size of the submission queue, must be called before the first
+	//	request to take effect.
+	//--------------------------------------------------------------------
+	inline bool set_entries(unsigned count) noexcept
+	{
+		return details::BIoReactor::select_entries(count);
+	}
+
+	//--------------------------------------------------------------------
+	inline bool is_available(void)
+	{
+		return details::BIoReactor::instance()->is_available();
+	}
+
+	//--------------------------------------------------------------------
+	//	the requests started by this thread in the scope are submitted by
+	//	one system call when it ends, none of them may be waited for
+	//	inside the scope. the scope must not span a co_await either, it
+	//	terminates if it ends on another thread, or over another scope.
+	//--------------------------------------------------------------------
+	class SubmitBatch
+	{
+	public:
+		SubmitBatch(void) noexcept :
+			_reactor{ details::BIoReactor::instance() },
+			_depth{ _reactor->begin_batch() }
+		{
+		}
+
+		~SubmitBatch(void)
+		{
+			_reactor->end_batch(_depth);
+		}
+
+		SubmitBatch(SubmitBatch const& other) = delete;
+		SubmitBatch& operator = (SubmitBatch const& other) = delete;
+
+		//--------------------------------------------------------------------
+
+	private:
+		details::BIoReactor*					_reactor{ nullptr };
+		unsigned								_depth{ 0u };
+
+	};
+
+	//--------------------------------------------------------------------
+	inline auto read(int fd, std::span<std::byte> buf, std::uint64_t offset)
+	{
+		return details::io_awaiter_t{ details::BIoOp::read, fd, buf.data(), buf.size(), offset };
+	}
+
+	//--------------------------------------------------------------------
+	inline auto write(int fd, std::span<std::byte const> buf, std::uint64_t offset)
+	{
+		return details::io_awaiter_t{ details::BIoOp::write, fd, const_cast<std::byte*>(buf.data()), buf.size(), offset };
+	}
+
+	//--------------------------------------------------------------------
+	inline auto fsync(int fd)
+	{
+		return details::io_awaiter_t{ details::BIoOp::fsync, fd, nullptr, 0u, 0u };
+	}
+
+	//--------------------------------------------------------------------
+	inline auto fdatasync(int fd)
+	{
+		return details::io_awaiter_t{ details::BIoOp::fdatasync, fd, nullptr, 0u, 0u };
+	}
+
+	//--------------------------------------------------------------------
+	//	registers the buffers of read_fixed() / write_fixed(), replacing
+	//	the ones before, which must not be in use by any request then.
+	//--------------------------------------------------------------------
+	inline bool register_buffers(std::span<std::span<std::byte> const> buffers)
+	{
+		return details::BIoReactor::instance()->register_buffers(buffers);
+	}
+
+	//--------------------------------------------------------------------
+	inline bool unregister_buffers(void)
+	{
+		return details::BIoReactor::instance()->unregister_buffers();
+	}
+
+	//--------------------------------------------------------------------
+	//	'buf' lies in the registered buffer 'buf_index'.
+	//--------------------------------------------------------------------
+	inline auto read_fixed(int fd, std::span<std::byte> buf, std::uint64_t offset, unsigned buf_index)
+	{
+		return details::io_awaiter_t{ details::BIoOp::read_fixed, fd, buf.data(), buf.size(), offset, buf_index };
+	}
+
+	//--------------------------------------------------------------------
+	inline auto write_fixed(int fd, std::span<std::byte const> buf, std::uint64_t offset, unsigned buf_index)
+	{
+		return details::io_awaiter_t{ details::BIoOp::write_fixed, fd, const_cast<std::byte*>(buf.data()), buf.size(), offset, buf_index };
+	}
+
+	//--------------------------------------------------------------------
+
+
+}
+
+
 //--------------------------------------------------------------------
 #endif // !_AGAVE_HPP__
 
@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------
 //	AgaveDetails.hpp.
 //	09/27/2022.				created.
-//	09/14/2024.				last modified.
+//	10/17/2026.				last modified.
 //--------------------------------------------------------------------
 //	*	Agave(TM) Coroutine Framework (based on ISO C++20 or later).
 //	*	if has any questions, 
@@ -18,6 +18,8 @@
 //	headers...
 //--------------------------------------------------------------------
 #include "BJobScheduler.h"
+#include "BThreadPool.h"
+#include "BIoReactor.h"
 
 #include <coroutine>
 #include <stdexcept>
@@ -26,6 +28,18 @@
 #include <future>
 #include <atomic>
 #include <condition_variable>
+#include <optional>
+#include <exception>
+#include <utility>
+#include <vector>
+#include <span>
+#include <deque>
+#include <tuple>
+#include <variant>
+#include <ranges>
+#include <concepts>
+#include <bit>
+#include <cerrno>
 
 
 //--------------------------------------------------------------------
@@ -46,530 +60,600 @@ namespace agave
 namespace agave::details
 {
 	//--------------------------------------------------------------------
-	//	background awaiter object.
+	//	per-thread size-class free lists for the coroutine frames and the
+	//	shared async data.
+	//	* the blocks are recycled by the thread which frees them, up to
+	//	  '_max_cached' blocks per class, the rest go back to the heap.
+	//	* the blocks bigger than the largest class go to the heap directly.
 	//--------------------------------------------------------------------
-	class bg_awaitable_t
+	class frame_pool_t
 	{
 	public:
-		constexpr bool await_ready() const noexcept { return false; }
-
-		void await_suspend(std::coroutine_handle<> h) const
+		//--------------------------------------------------------------------
+		static void* allocate(std::size_t size)
 		{
-			if (details::__BGThread)
-			{
-				details::__BGThread([h] { h.resume(); });
-			}
-			else
+			auto index = class_of(size);
+			if (index >= _class_count || __is_cache_dead)
+				return ::operator new(size);
+
+			auto& cache = local_cache();
+			if (auto block = cache._free[index])
 			{
-				std::thread([h] { h.resume(); }).detach();
+				cache._free[index] = block->_next;
+				--cache._count[index];
+				return block;
 			}
 
-		}
+			return ::operator new((index + 1u) * _granularity);
 
-		constexpr void await_resume() const noexcept {}
+		}
 
-	};
+		//--------------------------------------------------------------------
+		static void deallocate(void* p, std::size_t size) noexcept
+		{
+			if (!p)
+				return;
 
+			auto index = class_of(size);
+			if (index >= _class_count || __is_cache_dead)
+				return ::operator delete(p);
 
-	//--------------------------------------------------------------------
-	//	foreground awaiter object.
-	//--------------------------------------------------------------------
-	class fg_awaitable_t
-	{
-	public:
-		constexpr bool await_ready() const noexcept { return false; }
+			auto& cache = local_cache();
+			if (cache._count[index] >= _max_cached)
+				return ::operator delete(p);
 
-		void await_suspend(std::coroutine_handle<> h) const
-		{
-			if (details::__FGThread)
-			{
-				details::__FGThread([h] { h.resume(); });
-			}
-			else
-				h.resume();
+			auto block = static_cast<block_t*>(p);
+			block->_next = cache._free[index];
+			cache._free[index] = block;
+			++cache._count[index];
 
 		}
 
-		constexpr void await_resume() const noexcept {}
+		//--------------------------------------------------------------------
 
-	};
+	private:
+		//--------------------------------------------------------------------
+		static constexpr std::size_t		_granularity{ 64u };
+		static constexpr std::size_t		_class_count{ 16u };	// up to 1KB.
+		static constexpr std::size_t		_max_cached{ 256u };
 
+		static inline thread_local bool		__is_cache_dead{ false };
 
-	//--------------------------------------------------------------------
-	//  used for internal only.
-	//--------------------------------------------------------------------
-	class async_action_data_t
-	{
-	public:
-		std::coroutine_handle<>					_h;        // outer coroutine handle.
-		std::mutex								_mx;
-		std::condition_variable				_cv;
-		std::atomic_bool						_is_cancel{ false };
-		std::atomic_bool						_is_ready{ false };
-		std::function<void(void)>				_cancel_fn;
-		BJobToken								_cb_token{ nullptr };
-		bool									_cancellation_propagation{ true };
-		std::weak_ptr<async_action_data_t>			_next;
+		//--------------------------------------------------------------------
+		class block_t
+		{
+		public:
+			block_t*						_next;
 
-	};
+		};
 
+		//--------------------------------------------------------------------
+		class cache_t
+		{
+		public:
+			~cache_t()
+			{
+				__is_cache_dead = true;		// frees after this go to the heap.
 
-	//--------------------------------------------------------------------
-	//  used for internal only.
-	//--------------------------------------------------------------------
-	template <typename T>
-	class async_operation_data_t : public async_action_data_t
-	{
-	public:
-		T                        _val;
+				for (auto block : _free)
+				{
+					while (block)
+					{
+						auto next = block->_next;
+						::operator delete(block);
+						block = next;
+					}
+				}
 
-	};
+			}
 
+			block_t*						_free[_class_count]{};
+			std::size_t						_count[_class_count]{};
 
-	//--------------------------------------------------------------------
-	//  Async Data type traits.
-	//--------------------------------------------------------------------
-	template <typename T>
-	class AsyncDataTraits   // primary template.
-	{
-	public:
-		using AsyncDataType = async_operation_data_t<T>;
-	};
+		};
 
-	//--------------------------------------------------------------------
-	template <>
-	class AsyncDataTraits<void> // template specializations.
-	{
-	public:
-		using AsyncDataType = async_action_data_t;
-	};
+		//--------------------------------------------------------------------
+		static std::size_t class_of(std::size_t size) noexcept
+		{
+			return size ? (size - 1u) / _granularity : 0u;
+		}
 
-	//--------------------------------------------------------------------
-	template <typename T = void>
-	using AsyncDataType = AsyncDataTraits<T>::AsyncDataType;
+		//--------------------------------------------------------------------
+		static cache_t& local_cache(void) noexcept
+		{
+			static thread_local cache_t cache;
+			return cache;
+		}
+
+		//--------------------------------------------------------------------
+
+	};
 
 
 	//--------------------------------------------------------------------
-	//	standard time span awaiter object.
+	//	standard allocator on the frame pool, for allocate_shared.
 	//--------------------------------------------------------------------
-	template <typename Promise>
-	class timespan_awaiter_t
+	template <typename T>
+	class frame_allocator_t
 	{
 	public:
 		//--------------------------------------------------------------------
-		timespan_awaiter_t(
-			Promise* promise,
-			std::chrono::high_resolution_clock::duration dur) noexcept :
-			_promise{ promise }, _dur{ dur },
-			_async_data{ std::make_shared<AsyncDataType<>>() }
-		{
-			return;
-		}
-
-		//--------------------------------------------------------------------
-		timespan_awaiter_t(timespan_awaiter_t const& other) noexcept :
-			_promise{ other._promise }, _dur{ other._dur }, _h{ other._h },
-			_async_data{ other._async_data },
-			_is_awake{ other._is_awake.load(std::memory_order::consume) }
-		{
-			return;
-		}
+		using value_type = T;
 
 		//--------------------------------------------------------------------
-		timespan_awaiter_t(timespan_awaiter_t&& other) noexcept :
-			_promise{ other._promise }, _dur{ other._dur }, _h{ other._h },
-			_async_data{ other._async_data },
-			_is_awake{ other._is_awake.load(std::memory_order::consume) }
-		{
-			return;
-		}
+		frame_allocator_t(void) noexcept = default;
 
 		//--------------------------------------------------------------------
-		~timespan_awaiter_t()
+		template <typename U>
+		frame_allocator_t(frame_allocator_t<U> const&) noexcept
 		{
 			//
 		}
 
 		//--------------------------------------------------------------------
-		constexpr bool await_ready() const noexcept
+		T* allocate(std::size_t n)
 		{
-			return false;
-		}
+			static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+				"Agave: over-aligned types are not supported by the frame pool.");
 
-		//--------------------------------------------------------------------
-		void await_suspend(std::coroutine_handle<> h) noexcept
-		{
-			_h = h;
-			callback(std::bind(&timespan_awaiter_t::on_wakeup, this));
+			return static_cast<T*>(frame_pool_t::allocate(n * sizeof(T)));
 		}
 
 		//--------------------------------------------------------------------
-		constexpr void await_resume() const noexcept
+		void deallocate(T* p, std::size_t n) noexcept
 		{
-			return;
+			frame_pool_t::deallocate(p, n * sizeof(T));
 		}
 
 		//--------------------------------------------------------------------
-		operator bool() const noexcept
+		template <typename U>
+		bool operator == (frame_allocator_t<U> const&) const noexcept
 		{
-			return is_canceled();
+			return true;
 		}
 
 		//--------------------------------------------------------------------
-		bool is_canceled(void) const noexcept
-		{
-			if (_promise)
-				return _promise->_async_data->_is_cancel.load(std::memory_order::consume);
 
-			return false;
+	};
 
-		}
 
+	//--------------------------------------------------------------------
+	//	promise mixin placing the coroutine frame on the frame pool.
+	//--------------------------------------------------------------------
+	class pooled_frame_t
+	{
+	public:
 		//--------------------------------------------------------------------
-		void callback(std::function<void(void)> cancel_fn) const noexcept
+		static void* operator new(std::size_t size)
 		{
-			auto job_tok = details::BJobScheduler::instance_ptr()->add_job(_dur, cancel_fn);
-			_promise->cancellation_callback(cancel_fn, job_tok);
+			return frame_pool_t::allocate(size);
 		}
 
 		//--------------------------------------------------------------------
-
-
-	private:
-		//--------------------------------------------------------------------
-		void on_wakeup(void)
+		static void operator delete(void* p, std::size_t size) noexcept
 		{
-			if (_is_awake)
-				return;
-
-			_is_awake.store(true, std::memory_order::release);
-
-			_h.resume();
-
+			frame_pool_t::deallocate(p, size);
 		}
 
 		//--------------------------------------------------------------------
 
-	public:
-		//--------------------------------------------------------------------
-		Promise*                                        _promise;
-		std::chrono::high_resolution_clock::duration	_dur;
-		std::coroutine_handle<>							_h;
-		std::shared_ptr<AsyncDataType<>>		        _async_data;
-		std::atomic<bool>								_is_awake{ false };
-
-		//--------------------------------------------------------------------
-
 	};
 
 
 	//--------------------------------------------------------------------
-	//  dummy type for cancellation mechanism.
+	//	an executor runs the coroutines submitted to it, 'co_await
+	//	ex.schedule()' resumes on it, 'ex.submit(h)' resumes 'h' on it.
 	//--------------------------------------------------------------------
-	struct get_cancellation_token_t {};
+	template <typename A>
+	concept awaiter = requires(A& a, std::coroutine_handle<> h)
+	{
+		{ a.await_ready() } -> std::convertible_to<bool>;
+		a.await_suspend(h);
+		a.await_resume();
+	};
+
+	//--------------------------------------------------------------------
+	template <typename E>
+	concept executor = requires(E& ex, std::coroutine_handle<> h)
+	{
+		{ ex.schedule() } -> awaiter;
+		ex.submit(h);
+	};
 
 
 	//--------------------------------------------------------------------
-	//	token for cancellation.
+	//	non-owning reference to an executor, submits without allocation,
+	//	the executor must outlive it.
 	//--------------------------------------------------------------------
-	template <typename Promise>
-	class cancellation_token_t
+	class executor_ref_t
 	{
 	public:
 		//--------------------------------------------------------------------
-		cancellation_token_t(Promise* promise) noexcept : _promise{ promise }
-		{
-			//
-		}
+		executor_ref_t(void) noexcept = default;
 
 		//--------------------------------------------------------------------
-		constexpr bool await_ready() const noexcept
+		template <executor E>
+		executor_ref_t(E& ex) noexcept :
+			_ex{ &ex },
+			_submit{ [](void* ex, std::coroutine_handle<> h) { static_cast<E*>(ex)->submit(h); } }
 		{
-			return true;
+			//
 		}
 
 		//--------------------------------------------------------------------
-		constexpr void await_suspend(std::coroutine_handle<>) const noexcept
+		explicit operator bool() const noexcept
 		{
-			//
+			return _submit != nullptr;
 		}
 
 		//--------------------------------------------------------------------
-		agave::CancellationToken<Promise> await_resume() const noexcept
+		void submit(std::coroutine_handle<> h) const
 		{
-			return _promise;
+			_submit(_ex, h);
 		}
 
 		//--------------------------------------------------------------------
 
 	private:
-		//--------------------------------------------------------------------
-		Promise*						_promise;
-
-		//--------------------------------------------------------------------
+		void*									_ex{ nullptr };
+		void									(*_submit)(void* ex, std::coroutine_handle<> h) { nullptr };
 
 	};
 
 
 	//--------------------------------------------------------------------
-	//  progress data.
+	//	the executors of 'resume_background()' / 'resume_foreground()',
+	//	take precedence over the entries.
 	//--------------------------------------------------------------------
-	template <typename Progress>
-	class progress_data_t
+	inline executor_ref_t						__BGExecutor;
+	inline executor_ref_t						__FGExecutor;
+
+
+	//--------------------------------------------------------------------
+	//	background awaiter object.
+	//--------------------------------------------------------------------
+	class bg_awaitable_t
 	{
 	public:
-		Progress							_progress;
-		bool								_is_ready{ false };
-		bool								_is_finished{ false };
-		std::mutex							_access_mx;
-		std::coroutine_handle<>				_h;
+		constexpr bool await_ready() const noexcept { return false; }
+
+		void await_suspend(std::coroutine_handle<> h) const
+		{
+			if (details::__BGExecutor)
+			{
+				details::__BGExecutor.submit(h);
+			}
+			else if (details::__BGThread)
+			{
+				details::__BGThread([h] { h.resume(); });
+			}
+			else
+			{
+				details::BThreadPool::instance()->submit(h);
+			}
+
+		}
+
+		constexpr void await_resume() const noexcept {}
 
 	};
 
 
 	//--------------------------------------------------------------------
-	//  forward declarations.
+	//	foreground awaiter object.
 	//--------------------------------------------------------------------
-	template <typename Progress>
-	class progress_reporter_t;
+	class fg_awaitable_t
+	{
+	public:
+		constexpr bool await_ready() const noexcept { return false; }
+
+		void await_suspend(std::coroutine_handle<> h) const
+		{
+			if (details::__FGExecutor)
+			{
+				details::__FGExecutor.submit(h);
+			}
+			else if (details::__FGThread)
+			{
+				details::__FGThread([h] { h.resume(); });
+			}
+			else
+				h.resume();
+
+		}
+
+		constexpr void await_resume() const noexcept {}
+
+	};
 
 
 	//--------------------------------------------------------------------
-	//  progress reporter base.
+	//	a coroutine waiting on an async primitive (mutex, semaphore, latch,
+	//	event), linked into the primitive's list while suspended. the async
+	//	data of the coroutine refers to it meanwhile, the cancellation
+	//	dequeues it through '_cancel' in O(1).
 	//--------------------------------------------------------------------
-	template <typename Progress, typename Reporter = progress_reporter_t<Progress>>
-	class progress_reporter_base_t
+	class sync_waiter_t
 	{
-		//--------------------------------------------------------------------
-		//	friend class types.
-		//--------------------------------------------------------------------
-		template <typename>
-		friend class progress_controller_t;
+	public:
+		std::coroutine_handle<>					_h;
+		void									(*_cancel)(sync_waiter_t* waiter, BWorkBatch& batch) { nullptr };
+		sync_waiter_t*							_prev{ nullptr };	// guarded by the primitive.
+		sync_waiter_t*							_next{ nullptr };
+		bool									_is_queued{ false };
+		bool									_is_canceled{ false };
 
-		//--------------------------------------------------------------------
-		template <typename>
-		friend class async_progress_base_t;
+	};
 
-		//--------------------------------------------------------------------
-		template <typename>
-		friend class progress_reporter_t;
 
+	//--------------------------------------------------------------------
+	//  used for internal only.
+	//	* the completion is a single atomic state word, the completing
+	//	  coroutine and the outer awaiter race on it without any lock.
+	//	* blocking 'get()' waits on the state word itself (futex).
+	//--------------------------------------------------------------------
+	class async_action_data_t
+	{
+	public:
 		//--------------------------------------------------------------------
+		static constexpr unsigned				_ready_bit{ 1u };		// completed.
+		static constexpr unsigned				_awaited_bit{ 2u };		// '_h' is registered.
+		static constexpr unsigned				_blocked_bit{ 4u };		// a thread waits in 'get()'.
+		static constexpr unsigned				_cancel_bit{ 8u };
 
-	public:
 		//--------------------------------------------------------------------
-		bool has_next(void) const
+		bool is_ready(void) const noexcept
 		{
-			if (decltype(auto) reporter = static_cast<Reporter const*>(this))
-				return reporter->has_next();
-
-			return false;
-
+			return _state.load(std::memory_order::acquire) & _ready_bit;
 		}
 
 		//--------------------------------------------------------------------
-		operator bool() const
+		bool is_canceled(void) const noexcept
 		{
-			return has_next();
+			return _state.load(std::memory_order::acquire) & _cancel_bit;
 		}
 
 		//--------------------------------------------------------------------
+		void set_canceled(void) noexcept
+		{
+			_state.fetch_or(_cancel_bit, std::memory_order::release);
+		}
 
-	protected:
 		//--------------------------------------------------------------------
-		progress_reporter_base_t(std::shared_ptr<progress_data_t<Progress>> pg_data) :
-			_pg_data{ pg_data }
-		{
-			//
-		}
-
+		//	registers the outer awaiter, returns false if it completed in
+		//	the meantime, the awaiter shall not be suspended then.
 		//--------------------------------------------------------------------
-		progress_reporter_base_t(void)
+		bool set_awaiter(std::coroutine_handle<> h) noexcept
 		{
-			//
+			_h = h;
+			return !(_state.fetch_or(_awaited_bit, std::memory_order::acq_rel) & _ready_bit);
 		}
 
 		//--------------------------------------------------------------------
-
-
-	protected:
+		//	marks it as completed, wakes up the blocked threads, and returns
+		//	the outer awaiter to resume if any.
 		//--------------------------------------------------------------------
-		std::shared_ptr<progress_data_t<Progress>>              _pg_data;
+		std::coroutine_handle<> set_ready(void) noexcept
+		{
+			auto state = _state.fetch_or(_ready_bit, std::memory_order::acq_rel);
 
-		//--------------------------------------------------------------------
+			if (state & _blocked_bit)
+				_state.notify_all();
 
-	};
+			if (state & _awaited_bit)
+				return _h;
 
+			return nullptr;
 
-	//--------------------------------------------------------------------
-	//  progress reporter.
-	//--------------------------------------------------------------------
-	template <typename Progress>
-	class progress_reporter_t : public progress_reporter_base_t<Progress, progress_reporter_t<Progress>>
-	{
-	public:
-		//--------------------------------------------------------------------
-		progress_reporter_t(std::shared_ptr<progress_data_t<Progress>> pg_data) noexcept
-		{
-			this->_pg_data = pg_data;
 		}
 
 		//--------------------------------------------------------------------
-		progress_reporter_t(progress_reporter_base_t<Progress, progress_reporter_t<Progress>> const& other)
+		void wait_ready(void) noexcept
 		{
-			this->_pg_data = other._pg_data;
+			auto state = _state.load(std::memory_order::acquire);
+			if (state & _ready_bit)
+				return;
+
+			state = _state.fetch_or(_blocked_bit, std::memory_order::acq_rel) | _blocked_bit;
+			while (!(state & _ready_bit))
+			{
+				_state.wait(state, std::memory_order::acquire);
+				state = _state.load(std::memory_order::acquire);
+			}
+
 		}
 
 		//--------------------------------------------------------------------
-		constexpr bool await_ready() const noexcept
+		//	the cancellation tree, the children being awaited are linked
+		//	into an intrusive list guarded by the spin lock of the parent.
+		//--------------------------------------------------------------------
+		void lock_children(void) noexcept
 		{
-			std::lock_guard lck(this->_pg_data->_access_mx);
+			while (_children_lock.test_and_set(std::memory_order::acquire))
+			{
+				while (_children_lock.test(std::memory_order::relaxed))
+					std::this_thread::yield();
+			}
 
-			return this->_pg_data->_is_ready || this->_pg_data->_is_finished;
 		}
 
 		//--------------------------------------------------------------------
-		constexpr void await_suspend(std::coroutine_handle<> h) const noexcept
+		void unlock_children(void) noexcept
 		{
-			std::lock_guard lck{ this->_pg_data->_access_mx };
-			this->_pg_data->_h = h;
+			_children_lock.clear(std::memory_order::release);
 		}
 
 		//--------------------------------------------------------------------
-		Progress& await_resume() const noexcept
+		//	O(1), returns true if the child shall be canceled right away,
+		//	since this one was canceled before.
+		//--------------------------------------------------------------------
+		bool link_child(async_action_data_t* child) noexcept
 		{
-			std::lock_guard lck(this->_pg_data->_access_mx);
-			this->_pg_data->_is_ready = false;
-			this->_pg_data->_h = nullptr;
+			lock_children();
+
+			if (child->_parent)
+			{
+				unlock_children();
+				return false;
+			}
+
+			child->_parent = this;
+			child->_prev_sibling = nullptr;
+			child->_next_sibling = _first_child;
+			if (_first_child)
+				_first_child->_prev_sibling = child;
+
+			_first_child = child;
 
-			return this->_pg_data->_progress;
+			auto is_canceled_now = is_canceled() && _cancellation_propagation.load(std::memory_order::relaxed);
+			unlock_children();
+
+			return is_canceled_now;
 
 		}
 
 		//--------------------------------------------------------------------
-		bool has_next(void) const
+		//	O(1).
+		//--------------------------------------------------------------------
+		void unlink_child(async_action_data_t* child) noexcept
 		{
-			std::lock_guard lck(this->_pg_data->_access_mx);
-			return this->_pg_data->_is_ready || !this->_pg_data->_is_finished;
+			lock_children();
+
+			if (child->_parent == this)
+			{
+				if (child->_prev_sibling)
+					child->_prev_sibling->_next_sibling = child->_next_sibling;
+				else
+					_first_child = child->_next_sibling;
+
+				if (child->_next_sibling)
+					child->_next_sibling->_prev_sibling = child->_prev_sibling;
+
+				child->_parent = nullptr;
+			}
+
+			unlock_children();
+
 		}
 
+		//--------------------------------------------------------------------
+		std::coroutine_handle<>					_h;        // outer coroutine handle.
+		std::atomic<unsigned>					_state{ 0u };
+		BJobNode*								_timer{ nullptr };	// pending sleep, guarded by the scheduler.
+		sync_waiter_t*							_waiter{ nullptr };	// pending wait of a primitive, guarded by the children lock.
+		std::atomic<bool>						_cancellation_propagation{ true };
 
 		//--------------------------------------------------------------------
+		//	links of the cancellation tree, guarded by the parent's lock.
+		//--------------------------------------------------------------------
+		std::atomic_flag						_children_lock;
+		async_action_data_t*					_first_child{ nullptr };
+		async_action_data_t*					_parent{ nullptr };
+		async_action_data_t*					_prev_sibling{ nullptr };
+		async_action_data_t*					_next_sibling{ nullptr };
 
 	};
 
-    
-    //--------------------------------------------------------------------
-    //  progress controller.
-    //--------------------------------------------------------------------
-    template <typename Progress>
-    class progress_controller_t
-    {
-    public:
-        //--------------------------------------------------------------------
-        progress_controller_t(std::shared_ptr<progress_data_t<Progress>> pt_data) noexcept :
-            _pg_data(pt_data)
-        {
-            //
-        };
-
-        //--------------------------------------------------------------------
-        void report_progress(Progress&& progress, bool is_finished = false) noexcept
-        {
-			std::unique_lock lck{ _pg_data->_access_mx };
-
-			_pg_data->_is_ready = true;
-            _pg_data->_is_finished = is_finished;
-            _pg_data->_progress = std::move(progress);
 
-			if (_pg_data->_h)
-			{
-				lck.unlock();
-				_pg_data->_h();
-			}
-            
-            
-        }
+	//--------------------------------------------------------------------
+	//	cancels the coroutine and the whole tree of the awaited ones in
+	//	one pass. the visited ones stay locked until the end, thus none of
+	//	them can be unlinked (and released) meanwhile, and the pending
+	//	sleeps of the tree are removed by one call of the scheduler, the
+	//	pending waits of the primitives are dequeued. only the ones removed
+	//	here are woken up here, after unlocking.
+	//--------------------------------------------------------------------
+	inline void cancel_tree(async_action_data_t* root)
+	{
+		std::vector<async_action_data_t*> tree{ root };
 
-		//--------------------------------------------------------------------
-		void report_progress(Progress const& progress, bool is_finished = false)
+		for (std::size_t i = 0u; i < tree.size(); ++i)
 		{
-			std::unique_lock lck{ _pg_data->_access_mx };
-
-			_pg_data->_is_ready = true;
-			_pg_data->_is_finished = is_finished;
-			_pg_data->_progress = progress;
+			auto data = tree[i];
+			data->lock_children();
+			data->set_canceled();
 
-			if (_pg_data->_h)
-			{
-				lck.unlock();
-				_pg_data->_h();
-			}
+			if (!data->_cancellation_propagation.load(std::memory_order::relaxed))
+				continue;
 
+			for (auto child = data->_first_child; child; child = child->_next_sibling)
+				tree.push_back(child);
 		}
 
-        //--------------------------------------------------------------------
-        void finish(bool is_finished = true)
-        {
-			std::lock_guard lck{ _pg_data->_access_mx };
-
-            _pg_data->_is_finished = is_finished;
-        }
+		std::vector<BJobNode**> links;
+		std::vector<BJobNode*> removed(tree.size());
+		links.reserve(tree.size());
+		for (auto data : tree)
+			links.push_back(&data->_timer);
 
-        //--------------------------------------------------------------------
+		details::BJobScheduler::instance()->remove_jobs(links, removed);
 
-    private:
-        //--------------------------------------------------------------------
-        std::shared_ptr<progress_data_t<Progress>>              _pg_data;
+		BWorkBatch batch;
+		for (auto data : tree)
+		{
+			if (data->_waiter)
+				data->_waiter->_cancel(data->_waiter, batch);
+		}
 
-        //--------------------------------------------------------------------
+		// children first, a child can go away as soon as its parent is unlocked.
+		for (auto data = tree.rbegin(); data != tree.rend(); ++data)
+			(*data)->unlock_children();
 
-    };
+		for (auto node : removed)
+		{
+			if (node)	// removed, the wakeup is up to us.
+				node->_fire(node, batch);
+		}
 
+		if (!batch.empty())
+			details::BJobScheduler::dispatch(batch);
 
-	//--------------------------------------------------------------------
-	//  dummy type for progress reporting mechanism.
-	//--------------------------------------------------------------------
-	struct get_progress_controller_t {};
+	}
 
 
 	//--------------------------------------------------------------------
-	//	awaiter for progress controller.
+	//	links the awaited coroutine into the cancellation tree of the
+	//	awaiting one while the latter is suspended on it.
+	//	* the result of a temporary one is moved out, since its data goes
+	//	  away with the full expression.
 	//--------------------------------------------------------------------
-	template <typename Progress>
-	class progress_controller_awaiter_t
+	template <typename Awaiter, bool IsTemporary = false>
+	class cancellation_link_t
 	{
 	public:
 		//--------------------------------------------------------------------
-		progress_controller_awaiter_t(std::shared_ptr<progress_data_t<Progress>> pg_data) noexcept :
-			_pg_data{ pg_data }
+		bool await_ready()
 		{
-			//
+			return _awaiter.await_ready();
 		}
 
 		//--------------------------------------------------------------------
-		constexpr bool await_ready() const noexcept
+		auto await_suspend(std::coroutine_handle<> h)
 		{
-			return true;
-		}
+			_is_linked = true;
+			if (_parent->link_child(_child))
+				cancel_tree(_child);
 
-		//--------------------------------------------------------------------
-		constexpr void await_suspend(std::coroutine_handle<>) const noexcept
-		{
-			//
+			return _awaiter.await_suspend(h);
 		}
 
 		//--------------------------------------------------------------------
-		progress_controller_t<Progress> await_resume() const noexcept
+		decltype(auto) await_resume()
 		{
-			return _pg_data;
-		}
+			if (_is_linked)
+				_parent->unlink_child(_child);
 
-		//--------------------------------------------------------------------
+			if constexpr (IsTemporary)
+				return std::remove_cvref_t<decltype(_awaiter.await_resume())>(std::move(_awaiter.await_resume()));
+			else
+				return _awaiter.await_resume();
+		}
 
-	private:
 		//--------------------------------------------------------------------
-		std::shared_ptr<progress_data_t<Progress>>              _pg_data;
+		Awaiter									_awaiter;
+		async_action_data_t*					_parent;
+		async_action_data_t*					_child;
+		bool									_is_linked{ false };
 
 		//--------------------------------------------------------------------
 
@@ -577,848 +661,4649 @@ namespace agave::details
 
 
 	//--------------------------------------------------------------------
-	//  the base class of async action / async operation.
+	//  used for internal only.
 	//--------------------------------------------------------------------
-	template <typename Progress>
-	class async_progress_base_t
+	template <typename T>
+	class async_operation_data_t : public async_action_data_t
 	{
-        //--------------------------------------------------------------------
-        //  friend class types.
-        //--------------------------------------------------------------------
-        template <typename, typename, typename>
-        friend class promise_base_t;
-        
-        //--------------------------------------------------------------------
-
 	public:
-		//--------------------------------------------------------------------
-		async_progress_base_t() : _pg_data{ new progress_data_t<Progress> }
-		{
-			//
-		}
-
-		//--------------------------------------------------------------------
-		progress_reporter_base_t<Progress> get_progress_reporter(void)
-		{
-			return progress_reporter_base_t<Progress>(_pg_data);
-		}
-
-		//--------------------------------------------------------------------
-
-	protected:
-		//--------------------------------------------------------------------
-		std::shared_ptr<progress_data_t<Progress>>              _pg_data;
-
-		//--------------------------------------------------------------------
+		T                        _val;
 
 	};
 
 
 	//--------------------------------------------------------------------
-	//  specializations for async_progress_base_t class.
+	//  Async Data type traits.
 	//--------------------------------------------------------------------
-	template <>
-	class async_progress_base_t<void>
+	template <typename T>
+	class AsyncDataTraits   // primary template.
 	{
 	public:
-		//
+		using AsyncDataType = async_operation_data_t<T>;
+	};
 
+	//--------------------------------------------------------------------
+	template <>
+	class AsyncDataTraits<void> // template specializations.
+	{
+	public:
+		using AsyncDataType = async_action_data_t;
 	};
 
 	//--------------------------------------------------------------------
+	template <typename T = void>
+	using AsyncDataType = AsyncDataTraits<T>::AsyncDataType;
 
 
 	//--------------------------------------------------------------------
-	//	declarations.
+	//	a time point of any clock on the steady clock of the scheduler.
 	//--------------------------------------------------------------------
-	template <typename Progress> class async_action_t;
-	template <typename Progress> class async_action_promise_t;
-	template <typename T, typename P> class async_operation_t;
-	template <typename T, typename P> class async_operation_promise_t;
+	template <typename Clock, typename Duration>
+	inline BTimePoint to_job_time(std::chrono::time_point<Clock, Duration> tp) noexcept
+	{
+		if constexpr (std::is_same_v<Clock, BClock>)
+			return std::chrono::time_point_cast<BDuration>(tp);
+		else
+			return BClock::now() + std::chrono::duration_cast<BDuration>(tp - Clock::now());
+	}
 
 
 	//--------------------------------------------------------------------
-	//	*** for asynchronous function with no returned value ***
+	//	how late a sleep may wake up, to be coalesced with the close ones.
 	//--------------------------------------------------------------------
-	template <typename Progress = void, typename Action = async_action_t<Progress>>
-	class async_action_base_t : public async_progress_base_t<Progress>
+	class slack_t
 	{
-		//--------------------------------------------------------------------
-		//	friend class types.
-		//--------------------------------------------------------------------
-		template <typename, typename, typename>
-		friend class promise_base_t;
-
-		//--------------------------------------------------------------------
-		template <typename>
-		friend class async_action_t;
-
-		//--------------------------------------------------------------------
-
 	public:
-		//--------------------------------------------------------------------
-		void get(void)
-		{
-			if (auto action = static_cast<Action*>(this))
-				return action->get();
-            
-            throw std::runtime_error("Agave: bad inherited type.");
-		}
-
-		//--------------------------------------------------------------------
-		void cancel(void)
-		{
-			if (auto action = static_cast<Action*>(this))
-				return action->cancel();
-            
-            throw std::runtime_error("Agave: bad inherited type.");
-		}
+		BDuration								_dur{ BDuration::zero() };
 
-		//--------------------------------------------------------------------
-		using promise_type = async_action_promise_t<Progress>;
-
-		//--------------------------------------------------------------------
+	};
 
-	protected:
-		//--------------------------------------------------------------------
-		std::shared_ptr<AsyncDataType<>>		_async_data;
-		std::coroutine_handle<>					_h;             // current coroutine handle.
 
-		//--------------------------------------------------------------------
+	//--------------------------------------------------------------------
+	//	a sleep until an absolute deadline with slack.
+	//--------------------------------------------------------------------
+	class sleep_t
+	{
+	public:
+		BTimePoint								_tp;
+		BDuration								_slack{ BDuration::zero() };
 
 	};
 
 
 	//--------------------------------------------------------------------
-	//	implementations for async_action_base_t.
+	//	standard time span awaiter object.
+	//	* the awaiter itself is the timer node, it lives in the coroutine
+	//	  frame and is linked into the scheduler, thus sleeping costs no
+	//	  allocation.
+	//	* the deadline is absolute (steady clock), 'co_await duration' is
+	//	  converted once when awaited.
+	//	* '_timer' of the async data refers to it while it is pending, the
+	//	  cancellation removes it through there.
 	//--------------------------------------------------------------------
-	template <typename Progress = void>
-	class async_action_t : public async_action_base_t<Progress, async_action_t<Progress>>
+	template <typename Promise>
+	class timespan_awaiter_t : public BJobNode
 	{
 	public:
 		//--------------------------------------------------------------------
-		async_action_t(async_action_t const& other)
+		timespan_awaiter_t(
+			Promise* promise,
+			BTimePoint tp,
+			BDuration slack = BDuration::zero()) noexcept :
+			_promise{ promise }, _slack{ slack }
 		{
-			this->_async_data = other._async_data;
-			this->_h = other._h;
+			_tp = tp;
 		}
 
 		//--------------------------------------------------------------------
-		async_action_t(async_action_t&& other) noexcept
+		timespan_awaiter_t(timespan_awaiter_t const& other) = delete;
+		timespan_awaiter_t& operator = (timespan_awaiter_t const& other) = delete;
+
+		//--------------------------------------------------------------------
+		~timespan_awaiter_t()
 		{
-			this->_async_data = other._async_data;
-			this->_h = other._h;
+			//
 		}
 
 		//--------------------------------------------------------------------
-		async_action_t(async_action_base_t<Progress, async_action_t<Progress>> const& other)
+		constexpr bool await_ready() const noexcept
 		{
-			this->_async_data = other._async_data;
-			this->_h = other._h;
+			return false;
 		}
 
 		//--------------------------------------------------------------------
-		async_action_t(async_action_base_t<Progress, async_action_t<Progress>>&& other) noexcept
+		//	under the children lock, either the cancellation finds the sleep
+		//	pending, or the sleep finds it canceled and does not suspend.
+		//--------------------------------------------------------------------
+		bool await_suspend(std::coroutine_handle<> h) noexcept
 		{
-			this->_async_data = other._async_data;
-			this->_h = other._h;
-		}
+			auto data = _promise->_async_data.get();
+
+			_h = h;
+			_fire = &timespan_awaiter_t::on_wakeup;
+			_link = &data->_timer;
+
+			data->lock_children();
+
+			if (data->is_canceled())
+			{
+				data->unlock_children();
+				return false;
+			}
+
+			// may be resumed before unlocking, await_resume() waits for it.
+			details::BJobScheduler::instance()->add_job_at(_tp, this, _slack);
+			data->unlock_children();
 
+			return true;
+
+		}
 
 		//--------------------------------------------------------------------
-		//  methods for outer awaiter.
+		void await_resume() const noexcept
+		{
+			auto data = _promise->_async_data.get();
+			data->lock_children();
+			data->unlock_children();
+		}
+
 		//--------------------------------------------------------------------
-		bool await_ready() const noexcept
+		operator bool() const noexcept
 		{
-			return this->_async_data->_is_ready;
+			return is_canceled();
 		}
 
 		//--------------------------------------------------------------------
-		void await_suspend(std::coroutine_handle<> h) noexcept
+		bool is_canceled(void) const noexcept
 		{
-			this->_async_data->_h = h;
+			if (_promise)
+				return _promise->_async_data->is_canceled();
+
+			return false;
+
 		}
 
 		//--------------------------------------------------------------------
-		constexpr void await_resume() const noexcept
-        {
-            //
-        }
 
+
+	private:
 		//--------------------------------------------------------------------
-		void get(void)
+		//	expired or canceled, the resumption is added to the batch once
+		//	the node left the scheduler.
+		//--------------------------------------------------------------------
+		static void on_wakeup(BJobNode* node, BWorkBatch& batch)
 		{
-			if (this->_async_data->_is_ready)
-			{
-				return;
-			}
-			else
-			{
-				std::unique_lock lck{ this->_async_data->_mx };
-				if (this->_async_data->_is_ready)	// check again!
-					return;
-				this->_async_data->_cv.wait(lck);
-			}
-
+			batch.add(static_cast<timespan_awaiter_t*>(node)->_h);
 		}
 
 		//--------------------------------------------------------------------
-		void cancel(void)
-		{
-			this->_async_data->_is_cancel.store(true, std::memory_order::release);
 
-			if (this->_async_data->_cancellation_propagation)
-			{
-				auto async_data = this->_async_data->_next.lock();
-				while (async_data)
-				{
-					async_data->_is_cancel.store(true, std::memory_order::release);
-					if (async_data->_cancel_fn)
-					{
-						async_data->_cancel_fn();
-						details::BJobScheduler::instance_ptr()->remove_job(async_data->_cb_token);
-					}
+	public:
+		//--------------------------------------------------------------------
+		Promise*                                        _promise;
+		BDuration										_slack;
+		std::coroutine_handle<>							_h;
 
+		//--------------------------------------------------------------------
 
-					if (!async_data->_cancellation_propagation)
-						break;
-					async_data = async_data->_next.lock();
-				}
+	};
 
-			}
 
+	//--------------------------------------------------------------------
+	//  dummy type for cancellation mechanism.
+	//--------------------------------------------------------------------
+	struct get_cancellation_token_t {};
+
+
+	//--------------------------------------------------------------------
+	//  tag for the awaitables which the promises pass through as they are.
+	//--------------------------------------------------------------------
+	struct passthrough_awaitable_t {};
+
+	//--------------------------------------------------------------------
+	template <typename A>
+	concept passthrough_awaitable = std::is_base_of_v<passthrough_awaitable_t, std::remove_cvref_t<A>>;
+
+
+	//--------------------------------------------------------------------
+	//	'co_await resume_on(ex)', the awaiter of 'ex.schedule()' passed
+	//	through the promises.
+	//--------------------------------------------------------------------
+	template <awaiter Awaiter>
+	class resume_on_t : public passthrough_awaitable_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		bool await_ready(void)
+		{
+			return _awaiter.await_ready();
 		}
 
 		//--------------------------------------------------------------------
-		async_action_t(
-			std::coroutine_handle<> const& h,
-			std::shared_ptr<AsyncDataType<>> async_data)
+		decltype(auto) await_suspend(std::coroutine_handle<> h)
 		{
-			this->_async_data = async_data;
-			this->_h = h;
+			return _awaiter.await_suspend(h);
+		}
 
+		//--------------------------------------------------------------------
+		decltype(auto) await_resume(void)
+		{
+			return _awaiter.await_resume();
 		}
 
 		//--------------------------------------------------------------------
 
+	public:
+		Awaiter									_awaiter;
 
 	};
 
 
 	//--------------------------------------------------------------------
-	//  *** for asynchronous function with returned value of T ***
+	//	token for cancellation.
 	//--------------------------------------------------------------------
-	template <typename T, typename Progress = void, typename Operation = async_operation_t<T, Progress>>
-		requires(!std::is_void_v<T>)
-	class async_operation_base_t : public async_progress_base_t<Progress>
+	template <typename Promise>
+	class cancellation_token_t
 	{
+	public:
 		//--------------------------------------------------------------------
-		//  friend class types.
-		//--------------------------------------------------------------------
-		template <typename, typename, typename>
-		friend class promise_base_t;
-
-		//--------------------------------------------------------------------
-		template <typename, typename>
-		friend class async_operation_t;
+		cancellation_token_t(Promise* promise) noexcept : _promise{ promise }
+		{
+			//
+		}
 
 		//--------------------------------------------------------------------
+		constexpr bool await_ready() const noexcept
+		{
+			return true;
+		}
 
-	public:
 		//--------------------------------------------------------------------
-		T& get(void)
+		constexpr void await_suspend(std::coroutine_handle<>) const noexcept
 		{
-			if (auto operation = static_cast<Operation*>(this))
-				return operation->get();
-            
-            throw std::runtime_error("Agave: bad inherited type.");
+			//
 		}
 
 		//--------------------------------------------------------------------
-		void cancel(void)
+		agave::CancellationToken<Promise> await_resume() const noexcept
 		{
-			if (auto operation = static_cast<Operation*>(this))
-				return operation->cancel();
-            
-            throw std::runtime_error("Agave: bad inherited type.");
+			return _promise;
 		}
 
 		//--------------------------------------------------------------------
-		using promise_type = async_operation_promise_t<T, Progress>;
-
 
+	private:
 		//--------------------------------------------------------------------
+		Promise*						_promise;
 
-	protected:
 		//--------------------------------------------------------------------
-		std::shared_ptr<AsyncDataType<T>>				_async_data;
-		std::coroutine_handle<>                         _h;
 
-		//--------------------------------------------------------------------
+	};
 
+
+	//--------------------------------------------------------------------
+	//  what 'report_progress' does when the progress channel is full.
+	//--------------------------------------------------------------------
+	enum class progress_policy_t
+	{
+		coalesce_latest,	// overwrite the newest unread report.
+		drop_oldest,		// discard the oldest unread report.
+		block,				// wait until the reporter reads one (lossless).
 	};
 
 
 	//--------------------------------------------------------------------
-	//	implementations for async_operation_base_t.
+	//  progress data, a bounded single-producer / single-consumer ring of
+	//	reports. the consumer is resumed on its executor if one is set,
+	//	otherwise inline on the producer's thread.
+	//
+	//	when throttled, the producer only stores the latest report, and a
+	//	job of the scheduler publishes it at most once per interval.
 	//--------------------------------------------------------------------
-	template <typename T, typename Progress = void>
-	class async_operation_t : 
-		public async_operation_base_t<T, Progress, async_operation_t<T, Progress>>
+	template <typename Progress>
+	class progress_data_t : public BJobNode
 	{
 	public:
 		//--------------------------------------------------------------------
-		async_operation_t(async_operation_base_t<T, Progress, async_operation_t<T, Progress>> const& other)
+		template <typename P>
+		void push(P&& progress, bool is_finished)
 		{
-			this->_async_data = other._async_data;
-			this->_h = other._h;
-		}
+			std::unique_lock lck{ _access_mx };
+
+			auto h = enqueue(std::forward<P>(progress), is_finished, lck, true);
+			auto ex = _executor;
+			lck.unlock();
+
+			if (!h)
+				return;
+
+			if (ex)
+				ex.submit(h);
+			else
+				h.resume();
 
-		//--------------------------------------------------------------------
-		async_operation_t(async_operation_base_t<T, Progress, async_operation_t<T, Progress>>&& other) noexcept
-		{
-			this->_async_data = other._async_data;
-			this->_h = other._h;
 		}
 
 		//--------------------------------------------------------------------
-		async_operation_t(async_operation_t const& other)
+		Progress& pop(void)
 		{
-			this->_async_data = other._async_data;
-			this->_h = other._h;
+			std::lock_guard lck{ _access_mx };
+
+			if (_size)
+			{
+				_progress = std::move(_ring[_head]);
+				_head = (_head + 1) & (_ring.size() - 1);
+				--_size;
+
+				if (_policy == progress_policy_t::block)
+					_space_cv.notify_one();
+			}
+
+			return _progress;
+
 		}
 
 		//--------------------------------------------------------------------
-		async_operation_t(async_operation_t&& other) noexcept
+		void set_policy(progress_policy_t policy, std::size_t capacity)
 		{
-			this->_async_data = other._async_data;
-			this->_h = other._h;
-		}
+			std::lock_guard lck{ _access_mx };
 
+			_policy = policy;
+			_capacity = std::bit_ceil(std::max<std::size_t>(capacity, 1));
+			_space_cv.notify_one();
+		}
 
 		//--------------------------------------------------------------------
-		//	methods for outer awaiter.
+		//	producer side, a relaxed store and load on the hot path.
 		//--------------------------------------------------------------------
-		bool await_ready() const noexcept
+		void coalesce(Progress const& progress, std::shared_ptr<progress_data_t> const& self)
 		{
-			return this->_async_data->_is_ready;
+			if constexpr (std::is_trivially_copyable_v<Progress>)
+			{
+				_latest.store(progress, std::memory_order_relaxed);
+				_reported.store(_reported.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+				if (!_is_armed.load(std::memory_order_relaxed))
+					arm(self);
+			}
+
 		}
 
 		//--------------------------------------------------------------------
-		void await_suspend(std::coroutine_handle<> h) noexcept
+		bool is_throttled(void) const noexcept
 		{
-			this->_async_data->_h = h;
+			return _interval != BDuration::zero();
 		}
 
 		//--------------------------------------------------------------------
-		T& await_resume() const noexcept
+		//	the producer is gone, the pending report is published by the
+		//	next tick, which is the last one.
+		//--------------------------------------------------------------------
+		void close(void)
 		{
-			return this->_async_data->_val;
+			std::lock_guard lck{ _access_mx };
+			_is_closed = true;
 		}
 
 		//--------------------------------------------------------------------
-		T& get(void)
+
+	private:
+		//--------------------------------------------------------------------
+		//	appends a report with '_access_mx' held, returns the consumer to
+		//	resume, if any. 'block' only waits if 'can_block', otherwise the
+		//	newest report is overwritten.
+		//--------------------------------------------------------------------
+		template <typename P>
+		std::coroutine_handle<> enqueue(P&& progress, bool is_finished, std::unique_lock<std::mutex>& lck, bool can_block)
 		{
-			if (this->_async_data->_is_ready)
+			// (re)allocate the ring lazily, a new capacity applies once drained.
+			if (_ring.size() != _capacity && !_size)
 			{
-				return this->_async_data->_val;
+				_ring.clear();
+				_ring.resize(_capacity);
+				_head = 0;
 			}
-			else
+
+			auto mask = _ring.size() - 1;
+
+			if (_size == _ring.size())
 			{
-				std::unique_lock lck{ this->_async_data->_mx };
-				if (this->_async_data->_is_ready)		// check again!
-					return this->_async_data->_val;
+				if (_policy == progress_policy_t::block && can_block)
+				{
+					_space_cv.wait(lck, [this] { return _size < _ring.size(); });
+				}
+				else if (_policy == progress_policy_t::drop_oldest)
+				{
+					_head = (_head + 1) & mask;
+					--_size;
+				}
+				else
+				{
+					_ring[(_head + _size - 1) & mask] = std::forward<P>(progress);
+					_is_finished = is_finished;
 
-				this->_async_data->_cv.wait(lck);
-				return this->_async_data->_val;
+					return nullptr;
+				}
 			}
 
+			_ring[(_head + _size) & mask] = std::forward<P>(progress);
+			++_size;
+			_is_finished = is_finished;
+
+			return std::exchange(_h, nullptr);
+
 		}
 
 		//--------------------------------------------------------------------
-		void cancel(void)
+		//	the first tick is due at once, the data is kept alive until the
+		//	ticks stop.
+		//--------------------------------------------------------------------
+		void arm(std::shared_ptr<progress_data_t> const& self)
+		{
+			if (_is_armed.exchange(true, std::memory_order_acq_rel))
+				return;
+
+			{
+				std::lock_guard lck{ _access_mx };
+				_self = self;
+			}
+
+			_fire = &progress_data_t::on_tick;
+			_drop = &progress_data_t::on_drop;
+			BJobScheduler::instance()->add_job(BDuration::zero(), this);
+		}
+
+		//--------------------------------------------------------------------
+		//	runs on the scheduler thread, publishes the latest report if it
+		//	is new (and has moved by the step), the consumer is resumed on
+		//	its executor or the pool, never on this thread.
+		//--------------------------------------------------------------------
+		static void on_tick(BJobNode* node, BWorkBatch& batch)
+		{
+			tick(static_cast<progress_data_t*>(node), batch, false);
+		}
+
+		//--------------------------------------------------------------------
+		//	the scheduler discarded the pending tick (e.g. it went away),
+		//	the last one flushes and releases the data, a later report arms
+		//	it again.
+		//--------------------------------------------------------------------
+		static void on_drop(BJobNode* node, BWorkBatch& batch)
+		{
+			tick(static_cast<progress_data_t*>(node), batch, true);
+		}
+
+		//--------------------------------------------------------------------
+		static void tick(progress_data_t* self, BWorkBatch& batch, bool is_dropped)
 		{
-			this->_async_data->_is_cancel.store(true, std::memory_order::release);
+			std::shared_ptr<progress_data_t> keep_alive;
+			std::coroutine_handle<> h;
 
-			if (this->_async_data->_cancellation_propagation)
+			std::unique_lock lck{ self->_access_mx };
+
+			if constexpr (std::is_trivially_copyable_v<Progress>)
 			{
-				auto async_data = this->_async_data->_next.lock();
-				while (async_data)
+				auto reported = self->_reported.load(std::memory_order_acquire);
+
+				if (reported != self->_flushed && !self->_is_finished)
 				{
-					async_data->_is_cancel.store(true, std::memory_order::release);
-					if (async_data->_cancel_fn)
+					Progress progress = self->_latest.load(std::memory_order_relaxed);
+
+					if (is_dropped || self->_is_closed || self->has_moved(progress))
 					{
-						async_data->_cancel_fn();
-						details::BJobScheduler::instance_ptr()->remove_job(async_data->_cb_token);
+						self->_flushed = reported;
+						self->_published = progress;
+						h = self->enqueue(progress, false, lck, false);
 					}
+				}
+			}
 
+			auto is_stopped = is_dropped || self->_is_finished || self->_is_closed;
+			if (is_stopped)
+			{
+				self->_is_armed.store(false, std::memory_order_relaxed);
+				keep_alive = std::move(self->_self);
+			}
 
-					if (!async_data->_cancellation_propagation)
-						break;
-					async_data = async_data->_next.lock();
-				}
+			auto ex = self->_executor;
+			auto interval = self->_interval;
+			lck.unlock();
 
+			if (h)
+			{
+				if (ex)
+					ex.submit(h);
+				else
+					batch.add(h);
 			}
 
+			if (!is_stopped)
+				BJobScheduler::instance()->add_job(interval, self, interval / 4);
+
 		}
 
 		//--------------------------------------------------------------------
-		async_operation_t(
-			std::coroutine_handle<> const& h,
-			std::shared_ptr<AsyncDataType<T>> async_data)
+		bool has_moved(Progress const& progress) const noexcept
 		{
-			this->_async_data = async_data;
-			this->_h = h;
+			if constexpr (std::is_arithmetic_v<Progress>)
+				return (progress < _published ? _published - progress : progress - _published) >= _step;
+			else
+				return true;
 		}
 
+		//--------------------------------------------------------------------
+		using latest_type = std::conditional_t<std::is_trivially_copyable_v<Progress>, std::atomic<Progress>, Progress>;
 
 		//--------------------------------------------------------------------
 
+	public:
+		Progress							_progress;
+		std::vector<Progress, frame_allocator_t<Progress>>	_ring;
+		std::size_t							_head{ 0 };
+		std::size_t							_size{ 0 };
+		std::size_t							_capacity{ 1 };
+		progress_policy_t					_policy{ progress_policy_t::coalesce_latest };
+		bool								_is_finished{ false };
+		std::mutex							_access_mx;
+		std::condition_variable				_space_cv;
+		std::coroutine_handle<>				_h;
+		executor_ref_t						_executor;
+
+		// throttling, the interval and the step are set by the producer.
+		BDuration							_interval{ BDuration::zero() };
+		Progress							_step{};
+		latest_type							_latest{};
+		std::atomic<std::size_t>			_reported{ 0 };
+		std::atomic<bool>					_is_armed{ false };
+
+	private:
+		std::size_t							_flushed{ 0 };		// guarded by '_access_mx'.
+		Progress							_published{};
+		bool								_is_closed{ false };
+		std::shared_ptr<progress_data_t>	_self;				// while the ticks run.
 
 	};
 
-    
+
 	//--------------------------------------------------------------------
-	//  the base class of promise for async action / operation.
+	//  forward declarations.
 	//--------------------------------------------------------------------
-	template <typename T, typename Promise, typename Progress>
-	class promise_base_t
-	{
-	public:
-        //--------------------------------------------------------------------
-        progress_controller_awaiter_t<Progress>
-            await_transform(get_progress_controller_t t) noexcept
-        {
-            return _pg_data;
-        }
+	template <typename Progress>
+	class progress_reporter_t;
 
-        //--------------------------------------------------------------------
-        void init_progress(async_progress_base_t<Progress>* progress) noexcept
-        {
-            if (progress)
-                _pg_data = progress->_pg_data;
-        }
-        
+	//--------------------------------------------------------------------
+	template <typename T>
+	class future_awaiter_t;
+
+
+	//--------------------------------------------------------------------
+	//  progress reporter base.
+	//--------------------------------------------------------------------
+	template <typename Progress, typename Reporter = progress_reporter_t<Progress>>
+	class progress_reporter_base_t
+	{
 		//--------------------------------------------------------------------
-		cancellation_token_t<Promise>
-			await_transform(get_cancellation_token_t t) noexcept
-		{
-			return { static_cast<Promise*>(this) };
-		}
-        
+		//	friend class types.
 		//--------------------------------------------------------------------
-		timespan_awaiter_t<Promise>
-			await_transform(std::chrono::high_resolution_clock::duration t) noexcept
+		template <typename>
+		friend class progress_controller_t;
+
+		//--------------------------------------------------------------------
+		template <typename>
+		friend class async_progress_base_t;
+
+		//--------------------------------------------------------------------
+		template <typename>
+		friend class progress_reporter_t;
+
+		//--------------------------------------------------------------------
+
+	public:
+		//--------------------------------------------------------------------
+		bool has_next(void) const
 		{
-			timespan_awaiter_t<Promise> time_span_awaiter{ static_cast<Promise*>(this), t };
-			_async_data->_next = time_span_awaiter._async_data;
+			if (decltype(auto) reporter = static_cast<Reporter const*>(this))
+				return reporter->has_next();
+
+			return false;
 
-			return time_span_awaiter;
 		}
 
 		//--------------------------------------------------------------------
-		auto await_transform(bg_awaitable_t&& awaiter) noexcept
+		operator bool() const
 		{
-			return awaiter;
+			return has_next();
 		}
 
 		//--------------------------------------------------------------------
-		auto& await_transform(bg_awaitable_t const& awaiter)
+		//	resume the awaiting coroutine on 'ex' instead of the reporting
+		//	thread, 'ex' must outlive the reports.
+		//--------------------------------------------------------------------
+		template <executor E>
+		progress_reporter_base_t& set_executor(E& ex)
 		{
-			return awaiter;
+			std::lock_guard lck{ _pg_data->_access_mx };
+			_pg_data->_executor = ex;
+
+			return *this;
 		}
 
 		//--------------------------------------------------------------------
-		auto await_transform(fg_awaitable_t&& awaiter) noexcept
+
+	protected:
+		//--------------------------------------------------------------------
+		progress_reporter_base_t(std::shared_ptr<progress_data_t<Progress>> pg_data) :
+			_pg_data{ pg_data }
 		{
-			return awaiter;
+			//
 		}
 
 		//--------------------------------------------------------------------
-		auto& await_transform(fg_awaitable_t const& awaiter)
+		progress_reporter_base_t(void)
 		{
-			return awaiter;
+			//
 		}
 
 		//--------------------------------------------------------------------
-		template <typename P>
-		auto await_transform(async_action_base_t<P>&& awaiter) noexcept
+
+
+	protected:
+		//--------------------------------------------------------------------
+		std::shared_ptr<progress_data_t<Progress>>              _pg_data;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//  progress reporter.
+	//--------------------------------------------------------------------
+	template <typename Progress>
+	class progress_reporter_t : public progress_reporter_base_t<Progress, progress_reporter_t<Progress>>
+	{
+	public:
+		//--------------------------------------------------------------------
+		progress_reporter_t(std::shared_ptr<progress_data_t<Progress>> pg_data) noexcept
 		{
-			_async_data->_next = awaiter._async_data;
-			return awaiter;
+			this->_pg_data = pg_data;
 		}
 
 		//--------------------------------------------------------------------
-		template <typename P>
-		auto& await_transform(async_action_base_t<P> const& awaiter)
+		progress_reporter_t(progress_reporter_base_t<Progress, progress_reporter_t<Progress>> const& other)
 		{
-			_async_data->_next = awaiter._async_data;
-			return awaiter;
+			this->_pg_data = other._pg_data;
 		}
 
 		//--------------------------------------------------------------------
-		template <typename U, typename P>
-		auto await_transform(async_operation_base_t<U, P, async_operation_t<U, P>>&& awaiter) noexcept
+		bool await_ready() const noexcept
 		{
-			_async_data->_next = awaiter._async_data;
-			return awaiter;
+			std::lock_guard lck(this->_pg_data->_access_mx);
+
+			return this->_pg_data->_size || this->_pg_data->_is_finished;
 		}
 
 		//--------------------------------------------------------------------
-		template <typename U, typename P>
-		auto& await_transform(async_operation_base_t<U, P, async_operation_t<U, P>> const& awaiter)
+		bool await_suspend(std::coroutine_handle<> h) const noexcept
 		{
-			_async_data->_next = awaiter._async_data;
-			return awaiter;
+			std::lock_guard lck{ this->_pg_data->_access_mx };
+
+			// a report may have arrived since 'await_ready'.
+			if (this->_pg_data->_size || this->_pg_data->_is_finished)
+				return false;
+
+			this->_pg_data->_h = h;
+
+			return true;
 		}
 
 		//--------------------------------------------------------------------
-		template <typename P>
-		auto await_transform(progress_reporter_base_t<P>&& awaiter) noexcept
+		Progress& await_resume() const noexcept
 		{
-			return awaiter;
+			return this->_pg_data->pop();
 		}
 
 		//--------------------------------------------------------------------
-		template <typename P>
-		auto& await_transform(progress_reporter_base_t<P> const& awaiter)
+		bool has_next(void) const
 		{
-			return awaiter;
+			std::lock_guard lck(this->_pg_data->_access_mx);
+			return this->_pg_data->_size || !this->_pg_data->_is_finished;
 		}
 
-		//--------------------------------------------------------------------
-		std::shared_ptr<AsyncDataType<T>>                       _async_data;
-        std::shared_ptr<progress_data_t<Progress>>              _pg_data;
 
 		//--------------------------------------------------------------------
 
 	};
 
-
-	//--------------------------------------------------------------------
-	//  specializations for promise_base_t class.
+    
     //--------------------------------------------------------------------
-    template <typename T, typename Promise>
-    class promise_base_t<T, Promise, void>
+    //  progress controller.
+    //--------------------------------------------------------------------
+    template <typename Progress>
+    class progress_controller_t
     {
     public:
         //--------------------------------------------------------------------
-        void init_progress(async_progress_base_t<void>* progress) noexcept
-        {
-            // none
-        }
-        
-        //--------------------------------------------------------------------
-        cancellation_token_t<Promise>
-            await_transform(get_cancellation_token_t t) noexcept
+        progress_controller_t(std::shared_ptr<progress_data_t<Progress>> pt_data) noexcept :
+            _pg_data(pt_data)
         {
-            return { static_cast<Promise*>(this) };
-        }
-        
+            //
+        };
+
         //--------------------------------------------------------------------
-        timespan_awaiter_t<Promise>
-            await_transform(std::chrono::high_resolution_clock::duration t) noexcept
+        void report_progress(Progress&& progress, bool is_finished = false)
         {
-            timespan_awaiter_t<Promise> time_span_awaiter{ static_cast<Promise*>(this), t };
-            _async_data->_next = time_span_awaiter._async_data;
+            if (!is_finished && _pg_data->is_throttled())
+                return _pg_data->coalesce(progress, _pg_data);
 
-            return time_span_awaiter;
+            _pg_data->push(std::move(progress), is_finished);
         }
 
+		//--------------------------------------------------------------------
+		void report_progress(Progress const& progress, bool is_finished = false)
+		{
+			if (!is_finished && _pg_data->is_throttled())
+				return _pg_data->coalesce(progress, _pg_data);
+
+			_pg_data->push(progress, is_finished);
+		}
+
+		//--------------------------------------------------------------------
+		//	the channel holds 'capacity' unread reports (rounded up to a power
+		//	of two), 'block' stalls this producer until the reporter catches up.
+		//--------------------------------------------------------------------
+		void set_policy(progress_policy_t policy, std::size_t capacity = 64)
+		{
+			_pg_data->set_policy(policy, capacity);
+		}
+
+		//--------------------------------------------------------------------
+		//	publish at most one report per 'interval', the reports between
+		//	are coalesced and the finishing one is always published at once.
+		//	call before reporting, from the reporting coroutine.
+		//--------------------------------------------------------------------
+		void set_rate(BDuration interval)
+		{
+			static_assert(std::is_trivially_copyable_v<Progress>,
+				"Agave: throttled progress must be trivially copyable.");
+
+			_pg_data->_interval = interval;
+		}
+
+		//--------------------------------------------------------------------
+		//	as above, and skip the reports that have not moved by 'step'
+		//	since the last published one, e.g. every 1 percent.
+		//--------------------------------------------------------------------
+		void set_rate(BDuration interval, Progress step) requires std::is_arithmetic_v<Progress>
+		{
+			set_rate(interval);
+			_pg_data->_step = step;
+		}
+
         //--------------------------------------------------------------------
-        auto await_transform(bg_awaitable_t&& awaiter) noexcept
+        void finish(bool is_finished = true)
         {
-            return awaiter;
+			std::lock_guard lck{ _pg_data->_access_mx };
+
+            _pg_data->_is_finished = is_finished;
         }
 
         //--------------------------------------------------------------------
-        auto& await_transform(bg_awaitable_t const& awaiter)
-        {
-            return awaiter;
-        }
 
+    private:
         //--------------------------------------------------------------------
-        auto await_transform(fg_awaitable_t&& awaiter) noexcept
-        {
-            return awaiter;
-        }
+        std::shared_ptr<progress_data_t<Progress>>              _pg_data;
 
         //--------------------------------------------------------------------
-        auto& await_transform(fg_awaitable_t const& awaiter)
-        {
-            return awaiter;
-        }
 
+    };
+
+
+	//--------------------------------------------------------------------
+	//  dummy type for progress reporting mechanism.
+	//--------------------------------------------------------------------
+	struct get_progress_controller_t {};
+
+
+	//--------------------------------------------------------------------
+	//	awaiter for progress controller.
+	//--------------------------------------------------------------------
+	template <typename Progress>
+	class progress_controller_awaiter_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		progress_controller_awaiter_t(std::shared_ptr<progress_data_t<Progress>> pg_data) noexcept :
+			_pg_data{ pg_data }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		constexpr bool await_ready() const noexcept
+		{
+			return true;
+		}
+
+		//--------------------------------------------------------------------
+		constexpr void await_suspend(std::coroutine_handle<>) const noexcept
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		progress_controller_t<Progress> await_resume() const noexcept
+		{
+			return _pg_data;
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		std::shared_ptr<progress_data_t<Progress>>              _pg_data;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//  the base class of async action / async operation.
+	//--------------------------------------------------------------------
+	template <typename Progress>
+	class async_progress_base_t
+	{
         //--------------------------------------------------------------------
-		template <typename P>
-        auto await_transform(async_action_base_t<P>&& awaiter) noexcept
-        {
-            _async_data->_next = awaiter._async_data;
-            return awaiter;
-        }
+        //  friend class types.
+        //--------------------------------------------------------------------
+        template <typename, typename, typename>
+        friend class promise_base_t;
+        
+        //--------------------------------------------------------------------
+
+	public:
+		//--------------------------------------------------------------------
+		async_progress_base_t() :
+			_pg_data{ std::allocate_shared<progress_data_t<Progress>>(frame_allocator_t<progress_data_t<Progress>>{}) }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		progress_reporter_base_t<Progress> get_progress_reporter(void)
+		{
+			return progress_reporter_base_t<Progress>(_pg_data);
+		}
+
+		//--------------------------------------------------------------------
+
+	protected:
+		//--------------------------------------------------------------------
+		std::shared_ptr<progress_data_t<Progress>>              _pg_data;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//  specializations for async_progress_base_t class.
+	//--------------------------------------------------------------------
+	template <>
+	class async_progress_base_t<void>
+	{
+	public:
+		//
+
+	};
+
+	//--------------------------------------------------------------------
+
+
+	//--------------------------------------------------------------------
+	//	declarations.
+	//--------------------------------------------------------------------
+	template <typename Progress> class async_action_t;
+	template <typename Progress> class async_action_promise_t;
+	template <typename T, typename P> class async_operation_t;
+	template <typename T, typename P> class async_operation_promise_t;
+
+
+	//--------------------------------------------------------------------
+	//	*** for asynchronous function with no returned value ***
+	//--------------------------------------------------------------------
+	template <typename Progress = void, typename Action = async_action_t<Progress>>
+	class async_action_base_t : public async_progress_base_t<Progress>
+	{
+		//--------------------------------------------------------------------
+		//	friend class types.
+		//--------------------------------------------------------------------
+		template <typename, typename, typename>
+		friend class promise_base_t;
+
+		//--------------------------------------------------------------------
+		template <typename>
+		friend class async_action_t;
+
+		//--------------------------------------------------------------------
+		friend class join_access_t;
+
+		//--------------------------------------------------------------------
+
+	public:
+		//--------------------------------------------------------------------
+		void get(void)
+		{
+			if (auto action = static_cast<Action*>(this))
+				return action->get();
+            
+            throw std::runtime_error("Agave: bad inherited type.");
+		}
+
+		//--------------------------------------------------------------------
+		void cancel(void)
+		{
+			if (auto action = static_cast<Action*>(this))
+				return action->cancel();
+            
+            throw std::runtime_error("Agave: bad inherited type.");
+		}
+
+		//--------------------------------------------------------------------
+		using promise_type = async_action_promise_t<Progress>;
+
+		//--------------------------------------------------------------------
+
+	protected:
+		//--------------------------------------------------------------------
+		std::shared_ptr<AsyncDataType<>>		_async_data;
+		std::coroutine_handle<>					_h;             // current coroutine handle.
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	implementations for async_action_base_t.
+	//--------------------------------------------------------------------
+	template <typename Progress = void>
+	class async_action_t : public async_action_base_t<Progress, async_action_t<Progress>>
+	{
+	public:
+		//--------------------------------------------------------------------
+		async_action_t(async_action_t const& other)
+		{
+			this->_async_data = other._async_data;
+			this->_h = other._h;
+		}
+
+		//--------------------------------------------------------------------
+		async_action_t(async_action_t&& other) noexcept
+		{
+			this->_async_data = other._async_data;
+			this->_h = other._h;
+		}
+
+		//--------------------------------------------------------------------
+		async_action_t(async_action_base_t<Progress, async_action_t<Progress>> const& other)
+		{
+			this->_async_data = other._async_data;
+			this->_h = other._h;
+		}
+
+		//--------------------------------------------------------------------
+		async_action_t(async_action_base_t<Progress, async_action_t<Progress>>&& other) noexcept
+		{
+			this->_async_data = other._async_data;
+			this->_h = other._h;
+		}
+
+
+		//--------------------------------------------------------------------
+		//  methods for outer awaiter.
+		//--------------------------------------------------------------------
+		bool await_ready() const noexcept
+		{
+			return this->_async_data->is_ready();
+		}
+
+		//--------------------------------------------------------------------
+		bool await_suspend(std::coroutine_handle<> h) noexcept
+		{
+			return this->_async_data->set_awaiter(h);
+		}
+
+		//--------------------------------------------------------------------
+		constexpr void await_resume() const noexcept
+        {
+            //
+        }
+
+		//--------------------------------------------------------------------
+		void get(void)
+		{
+			this->_async_data->wait_ready();
+		}
+
+		//--------------------------------------------------------------------
+		void cancel(void)
+		{
+			details::cancel_tree(this->_async_data.get());
+		}
+
+		//--------------------------------------------------------------------
+		async_action_t(
+			std::coroutine_handle<> const& h,
+			std::shared_ptr<AsyncDataType<>> async_data)
+		{
+			this->_async_data = async_data;
+			this->_h = h;
+
+		}
+
+		//--------------------------------------------------------------------
+
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//  *** for asynchronous function with returned value of T ***
+	//--------------------------------------------------------------------
+	template <typename T, typename Progress = void, typename Operation = async_operation_t<T, Progress>>
+		requires(!std::is_void_v<T>)
+	class async_operation_base_t : public async_progress_base_t<Progress>
+	{
+		//--------------------------------------------------------------------
+		//  friend class types.
+		//--------------------------------------------------------------------
+		template <typename, typename, typename>
+		friend class promise_base_t;
+
+		//--------------------------------------------------------------------
+		template <typename, typename>
+		friend class async_operation_t;
+
+		//--------------------------------------------------------------------
+		friend class join_access_t;
+
+		//--------------------------------------------------------------------
+
+	public:
+		//--------------------------------------------------------------------
+		T& get(void)
+		{
+			if (auto operation = static_cast<Operation*>(this))
+				return operation->get();
+            
+            throw std::runtime_error("Agave: bad inherited type.");
+		}
+
+		//--------------------------------------------------------------------
+		void cancel(void)
+		{
+			if (auto operation = static_cast<Operation*>(this))
+				return operation->cancel();
+            
+            throw std::runtime_error("Agave: bad inherited type.");
+		}
+
+		//--------------------------------------------------------------------
+		using promise_type = async_operation_promise_t<T, Progress>;
+
+
+		//--------------------------------------------------------------------
+
+	protected:
+		//--------------------------------------------------------------------
+		std::shared_ptr<AsyncDataType<T>>				_async_data;
+		std::coroutine_handle<>                         _h;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	implementations for async_operation_base_t.
+	//--------------------------------------------------------------------
+	template <typename T, typename Progress = void>
+	class async_operation_t : 
+		public async_operation_base_t<T, Progress, async_operation_t<T, Progress>>
+	{
+	public:
+		//--------------------------------------------------------------------
+		async_operation_t(async_operation_base_t<T, Progress, async_operation_t<T, Progress>> const& other)
+		{
+			this->_async_data = other._async_data;
+			this->_h = other._h;
+		}
+
+		//--------------------------------------------------------------------
+		async_operation_t(async_operation_base_t<T, Progress, async_operation_t<T, Progress>>&& other) noexcept
+		{
+			this->_async_data = other._async_data;
+			this->_h = other._h;
+		}
+
+		//--------------------------------------------------------------------
+		async_operation_t(async_operation_t const& other)
+		{
+			this->_async_data = other._async_data;
+			this->_h = other._h;
+		}
+
+		//--------------------------------------------------------------------
+		async_operation_t(async_operation_t&& other) noexcept
+		{
+			this->_async_data = other._async_data;
+			this->_h = other._h;
+		}
+
+
+		//--------------------------------------------------------------------
+		//	methods for outer awaiter.
+		//--------------------------------------------------------------------
+		bool await_ready() const noexcept
+		{
+			return this->_async_data->is_ready();
+		}
+
+		//--------------------------------------------------------------------
+		bool await_suspend(std::coroutine_handle<> h) noexcept
+		{
+			return this->_async_data->set_awaiter(h);
+		}
+
+		//--------------------------------------------------------------------
+		T& await_resume() const noexcept
+		{
+			return this->_async_data->_val;
+		}
+
+		//--------------------------------------------------------------------
+		T& get(void)
+		{
+			this->_async_data->wait_ready();
+			return this->_async_data->_val;
+		}
+
+		//--------------------------------------------------------------------
+		void cancel(void)
+		{
+			details::cancel_tree(this->_async_data.get());
+		}
+
+		//--------------------------------------------------------------------
+		async_operation_t(
+			std::coroutine_handle<> const& h,
+			std::shared_ptr<AsyncDataType<T>> async_data)
+		{
+			this->_async_data = async_data;
+			this->_h = h;
+		}
+
+
+		//--------------------------------------------------------------------
+
+
+	};
+
+    
+	//--------------------------------------------------------------------
+	//  the base class of promise for async action / operation.
+	//--------------------------------------------------------------------
+	template <typename T, typename Promise, typename Progress>
+	class promise_base_t : public pooled_frame_t
+	{
+	public:
+        //--------------------------------------------------------------------
+        progress_controller_awaiter_t<Progress>
+            await_transform(get_progress_controller_t t) noexcept
+        {
+            return _pg_data;
+        }
+
+        //--------------------------------------------------------------------
+        ~promise_base_t(void)
+        {
+            // let the throttling ticks publish the last report and stop.
+            if (_pg_data && _pg_data->is_throttled())
+                _pg_data->close();
+        }
+
+        //--------------------------------------------------------------------
+        void init_progress(async_progress_base_t<Progress>* progress) noexcept
+        {
+            if (progress)
+                _pg_data = progress->_pg_data;
+        }
+        
+		//--------------------------------------------------------------------
+		cancellation_token_t<Promise>
+			await_transform(get_cancellation_token_t t) noexcept
+		{
+			return { static_cast<Promise*>(this) };
+		}
+        
+		//--------------------------------------------------------------------
+		timespan_awaiter_t<Promise>
+			await_transform(BDuration t) noexcept
+		{
+			return { static_cast<Promise*>(this), BClock::now() + t };
+		}
+
+		//--------------------------------------------------------------------
+		template <typename Clock, typename Duration>
+		timespan_awaiter_t<Promise>
+			await_transform(std::chrono::time_point<Clock, Duration> tp) noexcept
+		{
+			return { static_cast<Promise*>(this), to_job_time(tp) };
+		}
+
+		//--------------------------------------------------------------------
+		timespan_awaiter_t<Promise>
+			await_transform(sleep_t t) noexcept
+		{
+			return { static_cast<Promise*>(this), t._tp, t._slack };
+		}
+
+		//--------------------------------------------------------------------
+		auto await_transform(bg_awaitable_t&& awaiter) noexcept
+		{
+			return awaiter;
+		}
+
+		//--------------------------------------------------------------------
+		auto& await_transform(bg_awaitable_t const& awaiter)
+		{
+			return awaiter;
+		}
+
+		//--------------------------------------------------------------------
+		auto await_transform(fg_awaitable_t&& awaiter) noexcept
+		{
+			return awaiter;
+		}
+
+		//--------------------------------------------------------------------
+		auto& await_transform(fg_awaitable_t const& awaiter)
+		{
+			return awaiter;
+		}
+
+		//--------------------------------------------------------------------
+		template <typename P>
+		cancellation_link_t<async_action_t<P>>
+			await_transform(async_action_base_t<P> const& awaiter)
+		{
+			return { async_action_t<P>{ awaiter }, _async_data.get(), awaiter._async_data.get() };
+		}
+
+		//--------------------------------------------------------------------
+		template <typename U, typename P>
+		cancellation_link_t<async_operation_t<U, P>, true>
+			await_transform(async_operation_base_t<U, P, async_operation_t<U, P>>&& awaiter)
+		{
+			return { async_operation_t<U, P>{ awaiter }, _async_data.get(), awaiter._async_data.get() };
+		}
+
+		//--------------------------------------------------------------------
+		template <typename U, typename P>
+		cancellation_link_t<async_operation_t<U, P>>
+			await_transform(async_operation_base_t<U, P, async_operation_t<U, P>> const& awaiter)
+		{
+			return { async_operation_t<U, P>{ awaiter }, _async_data.get(), awaiter._async_data.get() };
+		}
+
+		//--------------------------------------------------------------------
+		template <passthrough_awaitable A>
+		decltype(auto) await_transform(A&& awaiter) noexcept
+		{
+			if constexpr (requires { awaiter.cancellation_data(); })
+				return cancellation_link_t<A&>{ awaiter, _async_data.get(), awaiter.cancellation_data() };
+			else if constexpr (requires { awaiter.bind_cancellation(_async_data.get()); })
+			{
+				awaiter.bind_cancellation(_async_data.get());
+				return std::forward<A>(awaiter);
+			}
+			else
+				return std::forward<A>(awaiter);
+		}
+
+		//--------------------------------------------------------------------
+		template <typename P>
+		auto await_transform(progress_reporter_base_t<P>&& awaiter) noexcept
+		{
+			return awaiter;
+		}
+
+		//--------------------------------------------------------------------
+		template <typename P>
+		auto& await_transform(progress_reporter_base_t<P> const& awaiter)
+		{
+			return awaiter;
+		}
+
+		//--------------------------------------------------------------------
+		std::shared_ptr<AsyncDataType<T>>                       _async_data;
+        std::shared_ptr<progress_data_t<Progress>>              _pg_data;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//  specializations for promise_base_t class.
+    //--------------------------------------------------------------------
+    template <typename T, typename Promise>
+    class promise_base_t<T, Promise, void> : public pooled_frame_t
+    {
+    public:
+        //--------------------------------------------------------------------
+        void init_progress(async_progress_base_t<void>* progress) noexcept
+        {
+            // none
+        }
+        
+        //--------------------------------------------------------------------
+        cancellation_token_t<Promise>
+            await_transform(get_cancellation_token_t t) noexcept
+        {
+            return { static_cast<Promise*>(this) };
+        }
+        
+        //--------------------------------------------------------------------
+		timespan_awaiter_t<Promise>
+			await_transform(BDuration t) noexcept
+		{
+			return { static_cast<Promise*>(this), BClock::now() + t };
+		}
+
+		//--------------------------------------------------------------------
+		template <typename Clock, typename Duration>
+		timespan_awaiter_t<Promise>
+			await_transform(std::chrono::time_point<Clock, Duration> tp) noexcept
+		{
+			return { static_cast<Promise*>(this), to_job_time(tp) };
+		}
+
+		//--------------------------------------------------------------------
+		timespan_awaiter_t<Promise>
+			await_transform(sleep_t t) noexcept
+		{
+			return { static_cast<Promise*>(this), t._tp, t._slack };
+		}
+
+        //--------------------------------------------------------------------
+        auto await_transform(bg_awaitable_t&& awaiter) noexcept
+        {
+            return awaiter;
+        }
+
+        //--------------------------------------------------------------------
+        auto& await_transform(bg_awaitable_t const& awaiter)
+        {
+            return awaiter;
+        }
+
+        //--------------------------------------------------------------------
+        auto await_transform(fg_awaitable_t&& awaiter) noexcept
+        {
+            return awaiter;
+        }
+
+        //--------------------------------------------------------------------
+        auto& await_transform(fg_awaitable_t const& awaiter)
+        {
+            return awaiter;
+        }
+
+		//--------------------------------------------------------------------
+		template <typename P>
+		cancellation_link_t<async_action_t<P>>
+			await_transform(async_action_base_t<P> const& awaiter)
+		{
+			return { async_action_t<P>{ awaiter }, _async_data.get(), awaiter._async_data.get() };
+		}
+
+		//--------------------------------------------------------------------
+		template <typename U, typename P>
+		cancellation_link_t<async_operation_t<U, P>, true>
+			await_transform(async_operation_base_t<U, P>&& awaiter)
+		{
+			return { async_operation_t<U, P>{ awaiter }, _async_data.get(), awaiter._async_data.get() };
+		}
+
+		//--------------------------------------------------------------------
+		template <typename U, typename P>
+		cancellation_link_t<async_operation_t<U, P>>
+			await_transform(async_operation_base_t<U, P> const& awaiter)
+		{
+			return { async_operation_t<U, P>{ awaiter }, _async_data.get(), awaiter._async_data.get() };
+		}
+
+		//--------------------------------------------------------------------
+		template <passthrough_awaitable A>
+		decltype(auto) await_transform(A&& awaiter) noexcept
+		{
+			if constexpr (requires { awaiter.cancellation_data(); })
+				return cancellation_link_t<A&>{ awaiter, _async_data.get(), awaiter.cancellation_data() };
+			else if constexpr (requires { awaiter.bind_cancellation(_async_data.get()); })
+			{
+				awaiter.bind_cancellation(_async_data.get());
+				return std::forward<A>(awaiter);
+			}
+			else
+				return std::forward<A>(awaiter);
+		}
+
+        //--------------------------------------------------------------------
+        template <typename P>
+        auto await_transform(progress_reporter_base_t<P>&& awaiter) noexcept
+        {
+            return awaiter;
+        }
+
+        //--------------------------------------------------------------------
+        template <typename P>
+        auto& await_transform(progress_reporter_base_t<P> const& awaiter)
+        {
+            return awaiter;
+        }
+
+        //--------------------------------------------------------------------
+        template <typename U>
+        auto& await_transform(std::future<U> const& future)
+        {
+            return future;
+        }
+        
+        //--------------------------------------------------------------------
+        template <typename U>
+        auto await_transform(std::future<U>&& future) noexcept
+        {
+            return future_awaiter_t<U>{ std::move(future), _async_data.get() };
+        }
+        
+        //--------------------------------------------------------------------
+        std::shared_ptr<AsyncDataType<T>>                       _async_data;
+
+        //--------------------------------------------------------------------
+
+    };
+
+
+	//--------------------------------------------------------------------
+	//	final awaiter of async action / operation.
+	//	* the frame is released first, then the completion is published
+	//	  and the outer awaiter is resumed by symmetric transfer, thus a
+	//	  chain of completions runs in constant stack space.
+	//--------------------------------------------------------------------
+	class final_awaiter_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		constexpr bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		//--------------------------------------------------------------------
+		template <typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept
+		{
+			auto async_data = std::move(h.promise()._async_data);
+			h.destroy();
+
+			if (async_data)
+			{
+				if (auto outer = async_data->set_ready())
+					return outer;
+			}
+
+			return std::noop_coroutine();
+
+		}
+
+		//--------------------------------------------------------------------
+		constexpr void await_resume() const noexcept
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	promise definition for async action.
+	//--------------------------------------------------------------------
+	template <typename Progress>
+	class async_action_promise_t : 
+		public promise_base_t<void, async_action_promise_t<Progress>, Progress>
+	{
+	public:
+		//--------------------------------------------------------------------
+		async_action_t<Progress> get_return_object(void)
+		{
+			this->_async_data = std::allocate_shared<AsyncDataType<>>(frame_allocator_t<AsyncDataType<>>{});
+            async_action_t<Progress> action = {
+                std::coroutine_handle<async_action_promise_t>::from_promise(*this),
+				this->_async_data };
+
+			// initialize the progress data.
+            this->init_progress(static_cast<async_progress_base_t<Progress>*>(&action));
+
+            return action;
+		}
+
+		//--------------------------------------------------------------------
+		constexpr std::suspend_never initial_suspend(void) const noexcept
+		{
+			return {};
+		}
+
+		//--------------------------------------------------------------------
+		constexpr final_awaiter_t final_suspend(void) const noexcept
+		{
+			return {};
+		}
+
+		//--------------------------------------------------------------------
+		constexpr void return_void(void) const noexcept
+		{
+			// completed by the final awaiter.
+		}
+
+		//--------------------------------------------------------------------
+		bool enable_cancellation_propagation(bool val) const
+		{
+			return this->_async_data->_cancellation_propagation.exchange(val);
+		}
+
+		//--------------------------------------------------------------------
+		[[noreturn]]
+		void unhandled_exception(void)
+		{
+			throw;
+		}
+
+		//--------------------------------------------------------------------
+		std::coroutine_handle<>					_h;
+
+
+		//--------------------------------------------------------------------
+
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	promise definition for async operation.
+	//--------------------------------------------------------------------
+	template <typename T, typename Progress>
+	class async_operation_promise_t : 
+		public promise_base_t<T, async_operation_promise_t<T, Progress>, Progress>
+	{
+	public:
+		//--------------------------------------------------------------------
+		async_operation_t<T, Progress> get_return_object(void)
+		{
+			this->_async_data = std::allocate_shared<AsyncDataType<T>>(frame_allocator_t<AsyncDataType<T>>{});
+			async_operation_t<T, Progress> action = {
+				std::coroutine_handle<async_operation_promise_t>::from_promise(*this),
+				this->_async_data };
+
+			// initialize the progress data.
+			this->init_progress(static_cast<async_progress_base_t<Progress>*>(&action));
+
+			return action;
+
+		}
+
+		//--------------------------------------------------------------------
+		constexpr std::suspend_never initial_suspend(void) const noexcept
+		{
+			return {};
+		}
+
+		//--------------------------------------------------------------------
+		constexpr final_awaiter_t final_suspend(void) const noexcept
+		{
+			return {};
+		}
+
+		//--------------------------------------------------------------------
+		void return_value(T const& val) noexcept (std::is_nothrow_copy_constructible_v<T>)
+		{
+			if (this->_async_data)
+			{
+				// set the current value, completed by the final awaiter.
+				this->_async_data->_val = val;
+			}
+
+		}
+
+		//--------------------------------------------------------------------
+		void return_value(T&& val) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this->_async_data)
+			{
+				// set the current value, completed by the final awaiter.
+				this->_async_data->_val = std::move(val);
+			}
+		}
+
+		//--------------------------------------------------------------------
+		bool enable_cancellation_propagation(bool val) const
+		{
+			return this->_async_data->_cancellation_propagation.exchange(val);
+		}
+
+		//--------------------------------------------------------------------
+		[[noreturn]]
+		void unhandled_exception(void)
+		{
+			throw;
+		}
+
+		//--------------------------------------------------------------------
+		std::coroutine_handle<>				    _h;
+
+
+		//--------------------------------------------------------------------
+
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	*** lazy task, started only when awaited or started explicitly ***
+	//	* awaited exactly once, the result is kept in the frame, with no
+	//	  shared data, lock or condition variable.
+	//	* the awaiter starts it and is resumed by symmetric transfer.
+	//--------------------------------------------------------------------
+	template <typename T = void> class task_t;
+	template <typename T> class task_promise_t;
+
+
+	//--------------------------------------------------------------------
+	//	final awaiter of task, resumes the awaiter if any, the frame is
+	//	released by the owning task.
+	//--------------------------------------------------------------------
+	class task_final_awaiter_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		constexpr bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		//--------------------------------------------------------------------
+		template <typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept
+		{
+			if (auto continuation = h.promise()._continuation)
+				return continuation;
+
+			return std::noop_coroutine();
+		}
+
+		//--------------------------------------------------------------------
+		constexpr void await_resume() const noexcept
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	the base class of promise for task.
+	//--------------------------------------------------------------------
+	class task_promise_base_t : public pooled_frame_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		constexpr std::suspend_always initial_suspend(void) const noexcept
+		{
+			return {};
+		}
+
+		//--------------------------------------------------------------------
+		constexpr task_final_awaiter_t final_suspend(void) const noexcept
+		{
+			return {};
+		}
+
+		//--------------------------------------------------------------------
+		void unhandled_exception(void) noexcept
+		{
+			_exception = std::current_exception();
+		}
+
+		//--------------------------------------------------------------------
+		void rethrow_if_exception(void) const
+		{
+			if (_exception)
+				std::rethrow_exception(_exception);
+		}
+
+		//--------------------------------------------------------------------
+		std::coroutine_handle<>					_continuation;
+		std::exception_ptr						_exception;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	promise definition for task.
+	//--------------------------------------------------------------------
+	template <typename T>
+	class task_promise_t : public task_promise_base_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		task_t<T> get_return_object(void) noexcept
+		{
+			return task_t<T>{ std::coroutine_handle<task_promise_t>::from_promise(*this) };
+		}
+
+		//--------------------------------------------------------------------
+		template <typename U>
+			requires(std::is_convertible_v<U&&, T>)
+		void return_value(U&& val) noexcept(std::is_nothrow_constructible_v<T, U&&>)
+		{
+			_val.emplace(std::forward<U>(val));
+		}
+
+		//--------------------------------------------------------------------
+		T take_value(void)
+		{
+			rethrow_if_exception();
+			return std::move(*_val);
+		}
+
+		//--------------------------------------------------------------------
+		std::optional<T>						_val;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//  specializations for task_promise_t class.
+	//--------------------------------------------------------------------
+	template <>
+	class task_promise_t<void> : public task_promise_base_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		task_t<void> get_return_object(void) noexcept;
+
+		//--------------------------------------------------------------------
+		constexpr void return_void(void) const noexcept
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		void take_value(void) const
+		{
+			rethrow_if_exception();
+		}
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//  eager async types bridging a started task.
+	//--------------------------------------------------------------------
+	template <typename T>
+	class TaskBridgeTraits   // primary template.
+	{
+	public:
+		using TaskBridgeType = async_operation_base_t<T>;
+	};
+
+	//--------------------------------------------------------------------
+	template <>
+	class TaskBridgeTraits<void> // template specializations.
+	{
+	public:
+		using TaskBridgeType = async_action_base_t<>;
+	};
+
+	//--------------------------------------------------------------------
+	template <typename T = void>
+	using TaskBridgeType = TaskBridgeTraits<T>::TaskBridgeType;
+
+
+	//--------------------------------------------------------------------
+	//	implementations for task.
+	//--------------------------------------------------------------------
+	template <typename T>
+	class task_t : public passthrough_awaitable_t
+	{
+		static_assert(!std::is_reference_v<T>, "Agave: task of reference type is not supported.");
+
+	public:
+		//--------------------------------------------------------------------
+		using promise_type = task_promise_t<T>;
+
+		//--------------------------------------------------------------------
+		explicit task_t(std::coroutine_handle<promise_type> h) noexcept : _h{ h }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		task_t(task_t&& other) noexcept : _h{ std::exchange(other._h, nullptr) }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		task_t& operator = (task_t&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (_h)
+					_h.destroy();
+				_h = std::exchange(other._h, nullptr);
+			}
+
+			return *this;
+
+		}
+
+		//--------------------------------------------------------------------
+		task_t(task_t const& other) = delete;
+		task_t& operator = (task_t const& other) = delete;
+
+		//--------------------------------------------------------------------
+		~task_t()
+		{
+			if (_h)
+				_h.destroy();
+		}
+
+
+		//--------------------------------------------------------------------
+		//  methods for outer awaiter.
+		//--------------------------------------------------------------------
+		bool await_ready() const noexcept
+		{
+			return _h.done();
+		}
+
+		//--------------------------------------------------------------------
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> h) noexcept
+		{
+			_h.promise()._continuation = h;
+			return _h;
+		}
+
+		//--------------------------------------------------------------------
+		T await_resume()
+		{
+			return _h.promise().take_value();
+		}
+
+
+		//--------------------------------------------------------------------
+		//	starts it on the current thread, the task is moved into the
+		//	returned async action / operation.
+		//--------------------------------------------------------------------
+		TaskBridgeType<T> start(void);
+
+		//--------------------------------------------------------------------
+		//	starts it on the background thread environment.
+		//--------------------------------------------------------------------
+		TaskBridgeType<T> start_background(void);
+
+		//--------------------------------------------------------------------
+		//	classical blocked method, starts it on the current thread.
+		//--------------------------------------------------------------------
+		T get(void);
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		std::coroutine_handle<promise_type>		_h;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	inline task_t<void> task_promise_t<void>::get_return_object(void) noexcept
+	{
+		return task_t<void>{ std::coroutine_handle<task_promise_t>::from_promise(*this) };
+	}
+
+
+	//--------------------------------------------------------------------
+	//	runs the task inside an eager async action / operation.
+	//--------------------------------------------------------------------
+	template <typename T>
+	inline TaskBridgeType<T> run_task_async(task_t<T> task, bool is_background)
+	{
+		if (is_background)
+			co_await bg_awaitable_t{ };
+
+		if constexpr (std::is_void_v<T>)
+			co_await std::move(task);
+		else
+			co_return co_await std::move(task);
+	}
+
+
+	//--------------------------------------------------------------------
+	template <typename T>
+	TaskBridgeType<T> task_t<T>::start(void)
+	{
+		return run_task_async(std::move(*this), false);
+	}
+
+
+	//--------------------------------------------------------------------
+	template <typename T>
+	TaskBridgeType<T> task_t<T>::start_background(void)
+	{
+		return run_task_async(std::move(*this), true);
+	}
+
+
+	//--------------------------------------------------------------------
+	template <typename T>
+	T task_t<T>::get(void)
+	{
+		if constexpr (std::is_void_v<T>)
+			start().get();
+		else
+			return std::move(start().get());
+	}
+
+
+	//--------------------------------------------------------------------
+	//	*** async generator ***
+	//	* lazy and pull-based, each 'co_await gen.next()' resumes the
+	//	  producer by symmetric transfer, and each 'co_yield' transfers
+	//	  back to the consumer, in lockstep, no item is ever lost.
+	//	* the yielded value stays in the producer frame, the consumer gets
+	//	  a pointer to it, valid until it pulls the next one.
+	//	* like task, the producer awaits the awaitables as they are.
+	//--------------------------------------------------------------------
+	template <typename T> class async_generator_t;
+
+
+	//--------------------------------------------------------------------
+	//	yield / final awaiter of async generator, transfers to the
+	//	consumer.
+	//--------------------------------------------------------------------
+	class generator_yield_awaiter_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		constexpr bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		//--------------------------------------------------------------------
+		template <typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept
+		{
+			return h.promise()._consumer;
+		}
+
+		//--------------------------------------------------------------------
+		constexpr void await_resume() const noexcept
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	promise definition for async generator.
+	//--------------------------------------------------------------------
+	template <typename T>
+	class generator_promise_t : public pooled_frame_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		using value_type = std::remove_reference_t<T>;
+
+		//--------------------------------------------------------------------
+		async_generator_t<T> get_return_object(void) noexcept
+		{
+			return async_generator_t<T>{ std::coroutine_handle<generator_promise_t>::from_promise(*this) };
+		}
+
+		//--------------------------------------------------------------------
+		constexpr std::suspend_always initial_suspend(void) const noexcept
+		{
+			return {};
+		}
+
+		//--------------------------------------------------------------------
+		constexpr generator_yield_awaiter_t final_suspend(void) const noexcept
+		{
+			return {};
+		}
+
+		//--------------------------------------------------------------------
+		//	the temporaries live until the producer is resumed again.
+		//--------------------------------------------------------------------
+		generator_yield_awaiter_t yield_value(value_type& val) noexcept
+		{
+			_val = std::addressof(val);
+			return {};
+		}
+
+		//--------------------------------------------------------------------
+		generator_yield_awaiter_t yield_value(value_type&& val) noexcept
+		{
+			_val = std::addressof(val);
+			return {};
+		}
+
+		//--------------------------------------------------------------------
+		constexpr void return_void(void) const noexcept
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		void unhandled_exception(void) noexcept
+		{
+			_exception = std::current_exception();
+		}
+
+		//--------------------------------------------------------------------
+		std::coroutine_handle<>					_consumer;
+		value_type*								_val{ nullptr };
+		std::exception_ptr						_exception;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	implementations for async generator.
+	//--------------------------------------------------------------------
+	template <typename T>
+	class async_generator_t
+	{
+		static_assert(!std::is_void_v<T>, "Agave: generator of void is not supported.");
+
+	public:
+		//--------------------------------------------------------------------
+		using promise_type = generator_promise_t<T>;
+		using value_type = typename promise_type::value_type;
+
+		//--------------------------------------------------------------------
+		//	'co_await gen.next()' resumes with a pointer to the next value,
+		//	or nullptr once the producer returned.
+		//--------------------------------------------------------------------
+		class next_awaiter_t : public passthrough_awaitable_t
+		{
+		public:
+			//--------------------------------------------------------------------
+			bool await_ready() const noexcept
+			{
+				return !_h || _h.done();
+			}
+
+			//--------------------------------------------------------------------
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> h) noexcept
+			{
+				_h.promise()._consumer = h;
+				return _h;
+			}
+
+			//--------------------------------------------------------------------
+			value_type* await_resume()
+			{
+				if (!_h)
+					return nullptr;
+
+				auto& promise = _h.promise();
+				if (!_h.done())
+					return promise._val;
+
+				if (auto exception = std::exchange(promise._exception, nullptr))
+					std::rethrow_exception(exception);
+
+				return nullptr;
+
+			}
+
+			//--------------------------------------------------------------------
+			std::coroutine_handle<promise_type>	_h;
+
+			//--------------------------------------------------------------------
+
+		};
+
+		//--------------------------------------------------------------------
+		explicit async_generator_t(std::coroutine_handle<promise_type> h) noexcept : _h{ h }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		async_generator_t(async_generator_t&& other) noexcept : _h{ std::exchange(other._h, nullptr) }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		async_generator_t& operator = (async_generator_t&& other) noexcept
+		{
+			if (this != &other)
+			{
+				if (_h)
+					_h.destroy();
+				_h = std::exchange(other._h, nullptr);
+			}
+
+			return *this;
+
+		}
+
+		//--------------------------------------------------------------------
+		async_generator_t(async_generator_t const& other) = delete;
+		async_generator_t& operator = (async_generator_t const& other) = delete;
+
+		//--------------------------------------------------------------------
+		//	the producer must not be running, it's suspended at a co_yield
+		//	(or has not started / has returned) then.
+		//--------------------------------------------------------------------
+		~async_generator_t()
+		{
+			if (_h)
+				_h.destroy();
+		}
+
+		//--------------------------------------------------------------------
+		next_awaiter_t next(void) noexcept
+		{
+			return { {}, _h };
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		std::coroutine_handle<promise_type>		_h;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	*** structured concurrency: when_all / when_any ***
+	//	* each child is awaited by a tiny helper coroutine, the helpers
+	//	  count down one atomic and the last one needed resumes the
+	//	  awaiter by symmetric transfer, thus the awaiter suspends once.
+	//	* the join data is linked into the cancellation tree of the
+	//	  awaiting coroutine, with the joined ones as its children.
+	//--------------------------------------------------------------------
+	class join_access_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		template <typename P>
+		static std::shared_ptr<async_action_data_t> data(async_action_base_t<P> const& async) noexcept
+		{
+			return async._async_data;
+		}
+
+		//--------------------------------------------------------------------
+		template <typename T, typename P>
+		static std::shared_ptr<async_action_data_t> data(async_operation_base_t<T, P> const& async) noexcept
+		{
+			return async._async_data;
+		}
+
+		//--------------------------------------------------------------------
+		template <typename P>
+		static std::monostate value(async_action_base_t<P>&) noexcept
+		{
+			return {};
+		}
+
+		//--------------------------------------------------------------------
+		template <typename T, typename P>
+		static T& value(async_operation_base_t<T, P>& async) noexcept
+		{
+			return async._async_data->_val;
+		}
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	template <typename Async>
+	concept joinable_async = requires(Async & async) { join_access_t::value(async); };
+
+	//--------------------------------------------------------------------
+	template <typename Async>
+	using join_value_t = std::remove_cvref_t<decltype(join_access_t::value(std::declval<Async&>()))>;
+
+
+	//--------------------------------------------------------------------
+	//	shared data of when_all / when_any.
+	//--------------------------------------------------------------------
+	class join_data_t : public async_action_data_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		static constexpr std::size_t			npos{ static_cast<std::size_t>(-1) };
+
+		//--------------------------------------------------------------------
+		~join_data_t(void)
+		{
+			for (auto& joined : _joined)
+				unlink_child(joined.get());
+		}
+
+		//--------------------------------------------------------------------
+		//	a child completed, returns the awaiter if it is the last one
+		//	needed, the losers of when_any are cancelled by the winner.
+		//--------------------------------------------------------------------
+		std::coroutine_handle<> arrive(std::size_t index) noexcept
+		{
+			if (_is_any)
+			{
+				auto winner = npos;
+				if (!_winner.compare_exchange_strong(winner, index, std::memory_order::acq_rel))
+					return std::noop_coroutine();
+
+				cancel_losers(index);
+			}
+
+			if (_pending.fetch_sub(1u, std::memory_order::acq_rel) == 1u)
+				return _continuation;
+
+			return std::noop_coroutine();
+
+		}
+
+		//--------------------------------------------------------------------
+		void cancel_losers(std::size_t winner) noexcept
+		{
+			for (std::size_t i = 0u; i < _joined.size(); ++i)
+			{
+				if (i != winner)
+					cancel_tree(_joined[i].get());
+			}
+
+		}
+
+		//--------------------------------------------------------------------
+		bool									_is_any{ false };
+		std::atomic<std::size_t>				_pending{ 0u };
+		std::atomic<std::size_t>				_winner{ npos };
+		std::coroutine_handle<>					_continuation;
+		std::vector<std::shared_ptr<async_action_data_t>>	_joined;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	final awaiter of the join helper, releases the frame first.
+	//--------------------------------------------------------------------
+	class join_final_awaiter_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		constexpr bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		//--------------------------------------------------------------------
+		template <typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept
+		{
+			auto join = std::move(h.promise()._join);
+			auto index = h.promise()._index;
+			h.destroy();
+
+			return join->arrive(index);
+
+		}
+
+		//--------------------------------------------------------------------
+		constexpr void await_resume() const noexcept
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	awaits the completion of one async data.
+	//--------------------------------------------------------------------
+	class data_awaiter_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		bool await_ready() const noexcept
+		{
+			return _data->is_ready();
+		}
+
+		//--------------------------------------------------------------------
+		bool await_suspend(std::coroutine_handle<> h) const noexcept
+		{
+			return _data->set_awaiter(h);
+		}
+
+		//--------------------------------------------------------------------
+		constexpr void await_resume() const noexcept
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		async_action_data_t*					_data;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	the join helper coroutine, started eagerly, owns nothing.
+	//--------------------------------------------------------------------
+	class join_child_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		class promise_type : public pooled_frame_t
+		{
+		public:
+			//--------------------------------------------------------------------
+			promise_type(std::shared_ptr<join_data_t> const& join, std::size_t index) noexcept :
+				_join{ join }, _index{ index }
+			{
+				//
+			}
+
+			//--------------------------------------------------------------------
+			constexpr join_child_t get_return_object(void) const noexcept
+			{
+				return {};
+			}
+
+			//--------------------------------------------------------------------
+			constexpr std::suspend_never initial_suspend(void) const noexcept
+			{
+				return {};
+			}
+
+			//--------------------------------------------------------------------
+			constexpr join_final_awaiter_t final_suspend(void) const noexcept
+			{
+				return {};
+			}
+
+			//--------------------------------------------------------------------
+			constexpr void return_void(void) const noexcept
+			{
+				//
+			}
+
+			//--------------------------------------------------------------------
+			void unhandled_exception(void) const noexcept
+			{
+				std::terminate();	// awaiting a child never throws.
+			}
+
+			//--------------------------------------------------------------------
+			std::shared_ptr<join_data_t>			_join;
+			std::size_t								_index;
+
+			//--------------------------------------------------------------------
+
+		};
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	inline join_child_t join_child_async(std::shared_ptr<join_data_t> const& join, std::size_t index)
+	{
+		co_await data_awaiter_t{ join->_joined[index].get() };
+	}
+
+
+	//--------------------------------------------------------------------
+	//	the base class of the when_all / when_any awaiters.
+	//--------------------------------------------------------------------
+	class join_awaiter_base_t : public passthrough_awaitable_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		join_awaiter_base_t(bool is_any, std::vector<std::shared_ptr<async_action_data_t>> children) :
+			_join{ std::allocate_shared<join_data_t>(frame_allocator_t<join_data_t>{}) }
+		{
+			_join->_is_any = is_any;
+			_join->_joined = std::move(children);
+
+			for (auto& joined : _join->_joined)
+				_join->link_child(joined.get());
+
+		}
+
+		//--------------------------------------------------------------------
+		bool await_ready() noexcept
+		{
+			auto& children = _join->_joined;
+
+			if (!_join->_is_any)
+			{
+				for (auto& child : children)
+				{
+					if (!child->is_ready())
+						return false;
+				}
+
+				return true;
+			}
+
+			for (std::size_t i = 0u; i < children.size(); ++i)
+			{
+				if (children[i]->is_ready())
+				{
+					_join->_winner.store(i, std::memory_order::relaxed);
+					_join->cancel_losers(i);
+					return true;
+				}
+			}
+
+			return children.empty();
+
+		}
+
+		//--------------------------------------------------------------------
+		//	the extra count keeps the helpers from resuming the awaiter
+		//	before all of them are started.
+		//--------------------------------------------------------------------
+		bool await_suspend(std::coroutine_handle<> h)
+		{
+			auto count = _join->_joined.size();
+
+			_join->_continuation = h;
+			_join->_pending.store((_join->_is_any ? 1u : count) + 1u, std::memory_order::relaxed);
+
+			for (std::size_t i = 0u; i < count; ++i)
+				join_child_async(_join, i);
+
+			return _join->_pending.fetch_sub(1u, std::memory_order::acq_rel) != 1u;
+
+		}
+
+		//--------------------------------------------------------------------
+		async_action_data_t* cancellation_data(void) const noexcept
+		{
+			return _join.get();
+		}
+
+		//--------------------------------------------------------------------
+
+	protected:
+		//--------------------------------------------------------------------
+		std::shared_ptr<join_data_t>			_join;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	when_all over a fixed set of async actions / operations, resumes
+	//	with a tuple of the results (std::monostate for the actions).
+	//--------------------------------------------------------------------
+	template <joinable_async... Asyncs>
+	class when_all_t : public join_awaiter_base_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		when_all_t(Asyncs const&... asyncs) :
+			join_awaiter_base_t{ false, { join_access_t::data(asyncs)... } }, _asyncs{ asyncs... }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		std::tuple<join_value_t<Asyncs>...> await_resume()
+		{
+			return std::apply([](Asyncs&... asyncs)
+				{
+					return std::tuple<join_value_t<Asyncs>...>{ join_access_t::value(asyncs)... };
+				}, _asyncs);
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		std::tuple<Asyncs...>					_asyncs;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	when_all over a range of async actions / operations of one type,
+	//	resumes with a vector of the results (nothing for the actions).
+	//--------------------------------------------------------------------
+	template <joinable_async Async>
+	class when_all_range_t : public join_awaiter_base_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		when_all_range_t(std::vector<Async> asyncs) :
+			join_awaiter_base_t{ false, datas_of(asyncs) }, _asyncs{ std::move(asyncs) }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		auto await_resume()
+		{
+			if constexpr (std::is_same_v<join_value_t<Async>, std::monostate>)
+				return;
+			else
+			{
+				std::vector<join_value_t<Async>> values;
+				values.reserve(_asyncs.size());
+				for (auto& async : _asyncs)
+					values.push_back(join_access_t::value(async));
+
+				return values;
+			}
+
+		}
+
+		//--------------------------------------------------------------------
+		static std::vector<std::shared_ptr<async_action_data_t>> datas_of(std::vector<Async> const& asyncs)
+		{
+			std::vector<std::shared_ptr<async_action_data_t>> datas;
+			datas.reserve(asyncs.size());
+			for (auto& async : asyncs)
+				datas.push_back(join_access_t::data(async));
+
+			return datas;
+
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		std::vector<Async>						_asyncs;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	when_any, resumes with the index of the first completed one, the
+	//	others are cancelled. the winner is ready, its 'get()' never blocks.
+	//--------------------------------------------------------------------
+	class when_any_t : public join_awaiter_base_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		when_any_t(std::vector<std::shared_ptr<async_action_data_t>> children) :
+			join_awaiter_base_t{ true, std::move(children) }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		std::size_t await_resume() const noexcept
+		{
+			return _join->_winner.load(std::memory_order::acquire);
+		}
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	*** deadlines: with_timeout / with_deadline ***
+	//	* the operation races one sleep in a when_any, the loser is
+	//	  cancelled, and a cancelled sleep leaves the scheduler through its
+	//	  intrusive link, no scan of the pending jobs.
+	//--------------------------------------------------------------------
+	class timeout_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		constexpr bool operator==(timeout_t const&) const noexcept = default;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	a value or an error, a small stand-in for C++23 std::expected.
+	//--------------------------------------------------------------------
+	template <typename T, typename E>
+	class expected_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		expected_t(T val) :
+			_val{ std::in_place_index<0>, std::move(val) }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		expected_t(E err) :
+			_val{ std::in_place_index<1>, std::move(err) }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		bool has_value(void) const noexcept
+		{
+			return _val.index() == 0u;
+		}
+
+		//--------------------------------------------------------------------
+		explicit operator bool() const noexcept
+		{
+			return has_value();
+		}
+
+		//--------------------------------------------------------------------
+		T& value(void)
+		{
+			if (!has_value())
+				throw std::runtime_error("Agave: no value.");
+
+			return std::get<0>(_val);
+		}
+
+		//--------------------------------------------------------------------
+		T& operator*() noexcept
+		{
+			return *std::get_if<0>(&_val);
+		}
+
+		//--------------------------------------------------------------------
+		T* operator->() noexcept
+		{
+			return std::get_if<0>(&_val);
+		}
+
+		//--------------------------------------------------------------------
+		E& error(void) noexcept
+		{
+			return *std::get_if<1>(&_val);
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		std::variant<T, E>						_val;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	template <typename E>
+	class expected_t<void, E>
+	{
+	public:
+		//--------------------------------------------------------------------
+		expected_t(void) = default;
+
+		//--------------------------------------------------------------------
+		expected_t(E err) :
+			_err{ std::move(err) }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		bool has_value(void) const noexcept
+		{
+			return !_err.has_value();
+		}
+
+		//--------------------------------------------------------------------
+		explicit operator bool() const noexcept
+		{
+			return has_value();
+		}
+
+		//--------------------------------------------------------------------
+		void value(void) const
+		{
+			if (!has_value())
+				throw std::runtime_error("Agave: no value.");
+		}
+
+		//--------------------------------------------------------------------
+		E& error(void) noexcept
+		{
+			return *_err;
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		std::optional<E>						_err;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	inline async_action_base_t<> sleep_until_async(BTimePoint tp)
+	{
+		co_await tp;
+	}
+
+
+	//--------------------------------------------------------------------
+	//	resumes with the result of the operation, or with timeout_t if the
+	//	sleep won, the operation is cancelled then. otherwise the sleep is
+	//	cancelled, even before it is linked into the scheduler, and its
+	//	frame goes away with the operation (see timespan_awaiter_t).
+	//--------------------------------------------------------------------
+	template <joinable_async Async>
+	class timeout_awaiter_t : public join_awaiter_base_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		using ValueType = std::conditional_t<std::is_same_v<join_value_t<Async>, std::monostate>, void, join_value_t<Async>>;
+
+		//--------------------------------------------------------------------
+		timeout_awaiter_t(Async const& async, async_action_base_t<> const& sleep) :
+			join_awaiter_base_t{ true, { join_access_t::data(async), join_access_t::data(sleep) } }, _async{ async }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		expected_t<ValueType, timeout_t> await_resume()
+		{
+			if (_join->_winner.load(std::memory_order::acquire) != 0u)
+				return timeout_t{};
+
+			if constexpr (std::is_void_v<ValueType>)
+				return {};
+			else
+				return join_access_t::value(_async);
+
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		Async									_async;
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	run loop, an executor drained by the threads which run it, e.g.
+	//	the main thread as the foreground executor.
+	//	* the submitted items go through a bounded lock-free MPSC ring
+	//	  (Vyukov), without allocation, and through a locked overflow
+	//	  list once the ring is full, in FIFO order per producer.
+	//	* one thread runs the loop at a time.
+	//--------------------------------------------------------------------
+	class run_loop_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		class schedule_awaiter_t
+		{
+		public:
+			bool await_ready(void) const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<> h) const { _loop->submit(h); }
+			void await_resume(void) const noexcept {}
+
+		public:
+			run_loop_t*							_loop;
+
+		};
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		class cell_t
+		{
+		public:
+			std::atomic<std::size_t>			_seq{ 0u };
+			void*								_item{ nullptr };
+
+		};
+
+		//--------------------------------------------------------------------
+		//	resumes the loop once 'op' completed.
+		//--------------------------------------------------------------------
+		class watch_t
+		{
+		public:
+			//--------------------------------------------------------------------
+			class promise_type : public pooled_frame_t
+			{
+			public:
+				constexpr watch_t get_return_object(void) const noexcept { return {}; }
+				constexpr std::suspend_never initial_suspend(void) const noexcept { return {}; }
+				constexpr std::suspend_never final_suspend(void) const noexcept { return {}; }
+				constexpr void return_void(void) const noexcept {}
+				void unhandled_exception(void) const noexcept { std::terminate(); }
+
+			};
+
+			//--------------------------------------------------------------------
+
+		};
+
+		//--------------------------------------------------------------------
+
+	public:
+		//--------------------------------------------------------------------
+		explicit run_loop_t(std::size_t capacity = 1024u) :
+			_cells{ std::make_unique<cell_t[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2u))) },
+			_mask{ std::bit_ceil(std::max<std::size_t>(capacity, 2u)) - 1u }
+		{
+			for (std::size_t i = 0u; i <= _mask; ++i)
+				_cells[i]._seq.store(i, std::memory_order::relaxed);
+		}
+
+		//--------------------------------------------------------------------
+		//	the items still queued are dropped, waits for the submitting
+		//	threads to leave.
+		//--------------------------------------------------------------------
+		~run_loop_t(void)
+		{
+			while (_producers.load(std::memory_order::acquire))
+				std::this_thread::yield();
+		}
+
+		//--------------------------------------------------------------------
+		run_loop_t(run_loop_t const& other) = delete;
+		run_loop_t& operator = (run_loop_t const& other) = delete;
+
+		//--------------------------------------------------------------------
+		schedule_awaiter_t schedule(void) noexcept
+		{
+			return { this };
+		}
+
+		//--------------------------------------------------------------------
+		void submit(std::coroutine_handle<> h)
+		{
+			push(h.address());
+		}
+
+		//--------------------------------------------------------------------
+		void submit(BWorkItem* item)
+		{
+			push(reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(item) | 1u));
+		}
+
+		//--------------------------------------------------------------------
+		void submit(std::function<void(void)> fn)
+		{
+			BWorkBatch batch;
+			batch.add(std::move(fn));
+			push(batch._items.front());
+		}
+
+		//--------------------------------------------------------------------
+		//	runs the items until 'stop()', sleeps while there is none.
+		//--------------------------------------------------------------------
+		void run(void)
+		{
+			run_while([this] { return !_is_stopped.load(std::memory_order::acquire); });
+			_is_stopped.store(false, std::memory_order::relaxed);
+		}
+
+		//--------------------------------------------------------------------
+		//	runs the items until 'op' completed, returns its result.
+		//--------------------------------------------------------------------
+		template <joinable_async Async>
+		auto run_until(Async op)
+		{
+			auto is_done = false;
+			watch_async(join_access_t::data(op).get(), is_done);
+			run_while([&is_done] { return !is_done; });
+
+			if constexpr (std::is_same_v<join_value_t<Async>, std::monostate>)
+				op.get();
+			else
+				return join_value_t<Async>{ op.get() };
+		}
+
+		//--------------------------------------------------------------------
+		//	makes the current (or the next) 'run()' return.
+		//--------------------------------------------------------------------
+		void stop(void)
+		{
+			_producers.fetch_add(1u, std::memory_order::acquire);
+			_is_stopped.store(true, std::memory_order::release);
+			wake_up();
+			_producers.fetch_sub(1u, std::memory_order::release);
+		}
+
+		//--------------------------------------------------------------------
+		//	runs one item if any, never blocks.
+		//--------------------------------------------------------------------
+		bool poll_one(void)
+		{
+			if (auto item = pop())
+			{
+				BWorkBatch::run(item);
+				return true;
+			}
+
+			return false;
+		}
+
+		//--------------------------------------------------------------------
+		//	runs the items queued by now (not the ones they queue), never
+		//	blocks, returns how many ran. e.g. once per frame of a GUI.
+		//--------------------------------------------------------------------
+		std::size_t poll(void)
+		{
+			auto count = size();
+			for (std::size_t i = 0u; i < count; ++i)
+			{
+				if (!poll_one())
+					return i;
+			}
+
+			return count;
+		}
+
+		//--------------------------------------------------------------------
+		//	the number of the queued items, a snapshot.
+		//--------------------------------------------------------------------
+		std::size_t size(void)
+		{
+			auto count = _tail.load(std::memory_order::acquire) - _head + (_pending.size() - _pending_head);
+			if (_is_overflowed.load(std::memory_order::acquire))
+			{
+				std::unique_lock lck(_overflow_mx);
+				count += _overflow.size();
+			}
+
+			return count;
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		watch_t watch_async(async_action_data_t* data, bool& is_done)
+		{
+			co_await data_awaiter_t{ data };
+			co_await schedule();
+			is_done = true;
+		}
+
+		//--------------------------------------------------------------------
+		template <typename Pred>
+		void run_while(Pred const& pred)
+		{
+			while (pred())
+			{
+				if (auto item = pop())
+				{
+					BWorkBatch::run(item);
+					continue;
+				}
+
+				// check again after registering as the waiter, any push later
+				// bumps the epoch.
+				auto epoch = _epoch.load(std::memory_order::seq_cst);
+				_is_waiting.store(true, std::memory_order::seq_cst);
+
+				if (auto item = pop())
+				{
+					_is_waiting.store(false, std::memory_order::relaxed);
+					BWorkBatch::run(item);
+					continue;
+				}
+
+				if (pred())
+					_epoch.wait(epoch, std::memory_order::seq_cst);
+
+				_is_waiting.store(false, std::memory_order::relaxed);
+			}
+		}
+
+		//--------------------------------------------------------------------
+		void push(void* item)
+		{
+			_producers.fetch_add(1u, std::memory_order::acquire);
+
+			if (_is_overflowed.load(std::memory_order::acquire) || !try_push(item))
+			{
+				std::unique_lock lck(_overflow_mx);
+				_overflow.push_back(item);
+				_is_overflowed.store(true, std::memory_order::release);
+			}
+
+			wake_up();
+			_producers.fetch_sub(1u, std::memory_order::release);
+		}
+
+		//--------------------------------------------------------------------
+		bool try_push(void* item) noexcept
+		{
+			auto pos = _tail.load(std::memory_order::relaxed);
+
+			while (true)
+			{
+				auto& cell = _cells[pos & _mask];
+				auto seq = cell._seq.load(std::memory_order::acquire);
+				auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+
+				if (!diff)
+				{
+					if (_tail.compare_exchange_weak(pos, pos + 1u, std::memory_order::relaxed))
+					{
+						cell._item = item;
+						cell._seq.store(pos + 1u, std::memory_order::release);
+						return true;
+					}
+				}
+				else if (diff < 0)
+					return false;	// full.
+				else
+					pos = _tail.load(std::memory_order::relaxed);
+			}
+		}
+
+		//--------------------------------------------------------------------
+		//	the overflowed items go after the ring items queued before them.
+		//--------------------------------------------------------------------
+		void* pop(void)
+		{
+			if (_pending_head < _pending.size())
+				return _pending[_pending_head++];
+
+			auto& cell = _cells[_head & _mask];
+			if (cell._seq.load(std::memory_order::acquire) == _head + 1u)
+			{
+				auto item = cell._item;
+				cell._seq.store(_head + _mask + 1u, std::memory_order::release);
+				++_head;
+				return item;
+			}
+
+			if (!_is_overflowed.load(std::memory_order::acquire))
+				return nullptr;
+
+			_pending.clear();
+			_pending_head = 0u;
+			{
+				std::unique_lock lck(_overflow_mx);
+				_pending.swap(_overflow);
+				_is_overflowed.store(false, std::memory_order::release);
+			}
+
+			return _pending_head < _pending.size() ? _pending[_pending_head++] : nullptr;
+		}
+
+		//--------------------------------------------------------------------
+		void wake_up(void)
+		{
+			_epoch.fetch_add(1u, std::memory_order::seq_cst);
+			if (_is_waiting.load(std::memory_order::seq_cst))
+				_epoch.notify_one();
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		std::unique_ptr<cell_t[]>				_cells;
+		std::size_t								_mask;
+		alignas(64) std::atomic<std::size_t>	_tail{ 0u };
+		alignas(64) std::size_t					_head{ 0u };		// the running thread only.
+		std::vector<void*>						_pending;			// ditto, swapped out of '_overflow'.
+		std::size_t								_pending_head{ 0u };
+		std::mutex								_overflow_mx;
+		std::vector<void*>						_overflow;
+		std::atomic<bool>						_is_overflowed{ false };
+		std::atomic<unsigned>					_epoch{ 0u };
+		std::atomic<bool>						_is_waiting{ false };
+		std::atomic<bool>						_is_stopped{ false };
+		std::atomic<unsigned>					_producers{ 0u };	// inside 'submit()' / 'stop()'.
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	backoff of the polls of std::future, the longest one bounds the
+	//	latency of a slow future.
+	//--------------------------------------------------------------------
+	class future_backoff_t
+	{
+	public:
+		static constexpr BDuration				_min{ std::chrono::microseconds(50) };
+		static inline std::atomic<BDuration>	_max{ std::chrono::milliseconds(1) };
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	awaiter of std::future.
+	//	* the pending futures are polled by the job scheduler with an
+	//	  exponential backoff, no thread per co_await, the awaiter is the
+	//	  job node itself.
+	//	* bound by the promise, '_timer' of the async data refers to it
+	//	  while it is pending, like a sleep. a canceled coroutine stops
+	//	  waiting, and resumes with T{} unless the future got ready
+	//	  meanwhile, a T which is not default constructible is waited for.
+	//--------------------------------------------------------------------
+	template <typename T>
+	class future_awaiter_t : public BJobNode
+	{
+	public:
+		//--------------------------------------------------------------------
+		static constexpr bool					_is_cancelable{ std::is_void_v<T> || std::is_default_constructible_v<T> };
+
+		//--------------------------------------------------------------------
+		explicit future_awaiter_t(std::future<T>&& future, async_action_data_t* data = nullptr) noexcept :
+			_future{ std::move(future) }, _data{ _is_cancelable ? data : nullptr }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		bool await_ready() const noexcept
+		{
+			return is_ready();
+		}
+
+		//--------------------------------------------------------------------
+		//	under the children lock, either the cancellation finds the poll
+		//	pending, or the poll finds it canceled and does not suspend.
+		//--------------------------------------------------------------------
+		bool await_suspend(std::coroutine_handle<> h)
+		{
+			_h = h;
+			_backoff = future_backoff_t::_min;
+			_fire = &future_awaiter_t::on_poll;
+
+			return poll_later();
+		}
+
+		//--------------------------------------------------------------------
+		T await_resume()
+		{
+			if (_data)	// may be resumed before the poll unlocked.
+			{
+				_data->lock_children();
+				_data->unlock_children();
+
+				if (_data->is_canceled() && !is_ready())
+				{
+					if constexpr (std::is_void_v<T>)
+						return;
+					else
+						return T{};
+				}
+			}
+
+			return _future.get();
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		bool is_ready() const noexcept
+		{
+			using namespace std::chrono_literals;
+
+			return _future.wait_for(0ms) != std::future_status::timeout;
+		}
+
+		//--------------------------------------------------------------------
+		//	the close polls of the many futures are coalesced by the slack.
+		//	returns false if canceled, not polled then.
+		//--------------------------------------------------------------------
+		bool poll_later(void)
+		{
+			if (!_data)
+			{
+				BJobScheduler::instance()->add_job(_backoff, this, _backoff / 4);
+				return true;
+			}
+
+			_link = &_data->_timer;
+			_data->lock_children();
+
+			if (_data->is_canceled())
+			{
+				_data->unlock_children();
+				return false;
+			}
+
+			BJobScheduler::instance()->add_job(_backoff, this, _backoff / 4);
+			_data->unlock_children();
+
+			return true;
+
+		}
+
+		//--------------------------------------------------------------------
+		//	runs on the scheduler thread, or by the cancellation which
+		//	removed it, resumes or backs off.
+		//--------------------------------------------------------------------
+		static void on_poll(BJobNode* node, BWorkBatch& batch)
+		{
+			auto self = static_cast<future_awaiter_t*>(node);
+
+			if (self->is_ready())
+				return batch.add(self->_h);
+
+			self->_backoff = std::min<BDuration>(self->_backoff * 2, future_backoff_t::_max.load(std::memory_order::relaxed));
+
+			if (!self->poll_later())
+				batch.add(self->_h);
+
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		std::future<T>							_future;
+		std::coroutine_handle<>					_h;
+		BDuration								_backoff{ future_backoff_t::_min };
+		async_action_data_t*					_data;
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	intrusive FIFO list of the waiters of a primitive, guarded by a
+	//	spin lock like the cancellation tree, held for a few stores only.
+	//--------------------------------------------------------------------
+	class sync_list_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		void lock(void) noexcept
+		{
+			while (_lock.test_and_set(std::memory_order::acquire))
+			{
+				while (_lock.test(std::memory_order::relaxed))
+					std::this_thread::yield();
+			}
+
+		}
+
+		//--------------------------------------------------------------------
+		void unlock(void) noexcept
+		{
+			_lock.clear(std::memory_order::release);
+		}
+
+		//--------------------------------------------------------------------
+		bool empty(void) const noexcept
+		{
+			return !_head;
+		}
+
+		//--------------------------------------------------------------------
+		void push_back(sync_waiter_t* waiter) noexcept
+		{
+			waiter->_prev = _tail;
+			waiter->_next = nullptr;
+			waiter->_is_queued = true;
+
+			if (_tail)
+				_tail->_next = waiter;
+			else
+				_head = waiter;
+
+			_tail = waiter;
+
+		}
+
+		//--------------------------------------------------------------------
+		//	O(1).
+		//--------------------------------------------------------------------
+		void erase(sync_waiter_t* waiter) noexcept
+		{
+			if (waiter->_prev)
+				waiter->_prev->_next = waiter->_next;
+			else
+				_head = waiter->_next;
+
+			if (waiter->_next)
+				waiter->_next->_prev = waiter->_prev;
+			else
+				_tail = waiter->_prev;
+
+			waiter->_is_queued = false;
+
+		}
+
+		//--------------------------------------------------------------------
+		sync_waiter_t* front(void) const noexcept
+		{
+			return _head;
+		}
+
+		//--------------------------------------------------------------------
+		sync_waiter_t* pop_front(void) noexcept
+		{
+			auto waiter = _head;
+			if (waiter)
+				erase(waiter);
+
+			return waiter;
+
+		}
+
+		//--------------------------------------------------------------------
+		//	dequeues the waiter if it is still queued, it is resumed by the
+		//	batch as canceled.
+		//--------------------------------------------------------------------
+		bool cancel(sync_waiter_t* waiter, BWorkBatch& batch) noexcept
+		{
+			if (!waiter->_is_queued)
+				return false;
+
+			erase(waiter);
+			waiter->_is_canceled = true;
+			batch.add(waiter->_h);
+
+			return true;
+
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		std::atomic_flag						_lock;
+		sync_waiter_t*							_head{ nullptr };
+		sync_waiter_t*							_tail{ nullptr };
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	the base of the awaiters of the primitives.
+	//	* the promises bind the async data of the awaiting coroutine, a
+	//	  canceled coroutine does not wait.
+	//--------------------------------------------------------------------
+	class sync_awaiter_base_t : public sync_waiter_t, public passthrough_awaitable_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		void bind_cancellation(async_action_data_t* data) noexcept
+		{
+			_data = data;
+		}
+
+		//--------------------------------------------------------------------
+
+	protected:
+		//--------------------------------------------------------------------
+		//	links it into the async data and queues it by 'enqueue()', which
+		//	returns false if it need not wait. returns whether suspended.
+		//--------------------------------------------------------------------
+		template <typename Enqueue>
+		bool suspend(std::coroutine_handle<> h, void (*cancel)(sync_waiter_t*, BWorkBatch&), Enqueue const& enqueue)
+		{
+			_h = h;
+			_cancel = cancel;
+
+			// may be resumed and gone once enqueued.
+			auto data = _data;
+			if (!data)
+				return enqueue();
+
+			data->lock_children();
+
+			if (data->is_canceled())
+			{
+				data->unlock_children();
+				_is_canceled = true;
+
+				return false;
+			}
+
+			data->_waiter = this;
+			_is_linked = true;
+
+			auto is_suspended = enqueue();
+			if (!is_suspended)
+				data->_waiter = nullptr;
+
+			data->unlock_children();
+
+			return is_suspended;
+
+		}
+
+		//--------------------------------------------------------------------
+		void unlink(void) noexcept
+		{
+			if (_is_linked)
+			{
+				_data->lock_children();
+				_data->_waiter = nullptr;
+				_data->unlock_children();
+			}
+
+		}
+
+		//--------------------------------------------------------------------
+
+	protected:
+		async_action_data_t*					_data{ nullptr };
+		bool									_is_linked{ false };
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	awaiter of a primitive, resumes with false if canceled.
+	//	* the primitive provides 'try_wait()' (the lock-free fast path),
+	//	  'enqueue(waiter)' returning false if it passed meanwhile, and
+	//	  'cancel(waiter, batch)'.
+	//--------------------------------------------------------------------
+	template <typename Primitive>
+	class sync_awaiter_t : public sync_awaiter_base_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		explicit sync_awaiter_t(Primitive* primitive) noexcept :
+			_primitive{ primitive }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		bool await_ready(void) noexcept
+		{
+			return _primitive->try_wait();
+		}
+
+		//--------------------------------------------------------------------
+		bool await_suspend(std::coroutine_handle<> h)
+		{
+			return suspend(h, &sync_awaiter_t::on_cancel, [this] { return _primitive->enqueue(this); });
+		}
+
+		//--------------------------------------------------------------------
+		bool await_resume(void) noexcept
+		{
+			unlink();
+			return !_is_canceled;
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		//	called by the cancellation with the children lock held.
+		//--------------------------------------------------------------------
+		static void on_cancel(sync_waiter_t* waiter, BWorkBatch& batch)
+		{
+			static_cast<sync_awaiter_t*>(waiter)->_primitive->cancel(waiter, batch);
+		}
+
+		//--------------------------------------------------------------------
+
+	protected:
+		Primitive*								_primitive;
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	async counting semaphore, suspends the coroutine instead of the
+	//	thread, the waiters are served in FIFO order.
+	//	* the state word is the count of permits shifted by one and a bit
+	//	  set while there are waiters, acquiring and releasing without
+	//	  waiters is a single CAS.
+	//	* a released permit is handed over to the first waiter directly,
+	//	  which is resumed through the scheduler's dispatch.
+	//--------------------------------------------------------------------
+	class async_semaphore_t
+	{
+		//--------------------------------------------------------------------
+		//	friend class types.
+		//--------------------------------------------------------------------
+		friend class sync_awaiter_t<async_semaphore_t>;
+
+		//--------------------------------------------------------------------
+
+	public:
+		//--------------------------------------------------------------------
+		explicit async_semaphore_t(std::ptrdiff_t count = 0) noexcept :
+			_state{ count * 2 }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		async_semaphore_t(async_semaphore_t const& other) = delete;
+		async_semaphore_t& operator = (async_semaphore_t const& other) = delete;
+
+		//--------------------------------------------------------------------
+		//	'co_await sem.acquire()', resumes with false if canceled, which
+		//	acquired nothing.
+		//--------------------------------------------------------------------
+		[[nodiscard]]
+		sync_awaiter_t<async_semaphore_t> acquire(void) noexcept
+		{
+			return sync_awaiter_t<async_semaphore_t>{ this };
+		}
+
+		//--------------------------------------------------------------------
+		bool try_acquire(void) noexcept
+		{
+			auto state = _state.load(std::memory_order::relaxed);
+
+			// does not overtake the waiters.
+			while (state >= 2 && !(state & _waiters_bit))
+			{
+				if (_state.compare_exchange_weak(state, state - 2, std::memory_order::acquire, std::memory_order::relaxed))
+					return true;
+			}
+
+			return false;
+
+		}
+
+		//--------------------------------------------------------------------
+		void release(std::ptrdiff_t count = 1)
+		{
+			auto state = _state.load(std::memory_order::relaxed);
+
+			while (!(state & _waiters_bit))
+			{
+				if (_state.compare_exchange_weak(state, state + count * 2, std::memory_order::release, std::memory_order::relaxed))
+					return;
+			}
+
+			BWorkBatch batch;
+			_waiters.lock();
+
+			for (; count && !_waiters.empty(); --count)
+				batch.add(_waiters.pop_front()->_h);
+
+			if (_waiters.empty())
+				clear_waiters(count);
+
+			_waiters.unlock();
+
+			if (!batch.empty())
+				BJobScheduler::dispatch(batch);
+
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		bool try_wait(void) noexcept
+		{
+			return try_acquire();
+		}
+
+		//--------------------------------------------------------------------
+		bool enqueue(sync_waiter_t* waiter) noexcept
+		{
+			_waiters.lock();
+
+			auto state = _state.load(std::memory_order::relaxed);
+			for (;;)
+			{
+				if (state >= 2 && !(state & _waiters_bit))
+				{
+					if (_state.compare_exchange_weak(state, state - 2, std::memory_order::acquire, std::memory_order::relaxed))
+					{
+						_waiters.unlock();
+						return false;
+					}
+				}
+				else if ((state & _waiters_bit) ||
+					_state.compare_exchange_weak(state, state | _waiters_bit, std::memory_order::relaxed))
+					break;
+			}
+
+			_waiters.push_back(waiter);
+			_waiters.unlock();
+
+			return true;
+
+		}
+
+		//--------------------------------------------------------------------
+		void cancel(sync_waiter_t* waiter, BWorkBatch& batch) noexcept
+		{
+			_waiters.lock();
+
+			if (_waiters.cancel(waiter, batch) && _waiters.empty())
+				clear_waiters(0);
+
+			_waiters.unlock();
+
+		}
+
+		//--------------------------------------------------------------------
+		//	with the list locked and empty, adds the permits left over.
+		//--------------------------------------------------------------------
+		void clear_waiters(std::ptrdiff_t count) noexcept
+		{
+			auto state = _state.load(std::memory_order::relaxed);
+
+			while (!_state.compare_exchange_weak(state, (state & ~_waiters_bit) + count * 2,
+				std::memory_order::release, std::memory_order::relaxed));
+
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		static constexpr std::ptrdiff_t			_waiters_bit{ 1 };
+
+		std::atomic<std::ptrdiff_t>				_state;
+		sync_list_t								_waiters;
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	async mutex, a semaphore of one permit, 'co_await mtx.lock()'
+	//	resumes with a scoped guard.
+	//--------------------------------------------------------------------
+	class async_mutex_t : private async_semaphore_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		//	unlocks when it goes away, does not own it if canceled.
+		//--------------------------------------------------------------------
+		class guard_t
+		{
+		public:
+			//--------------------------------------------------------------------
+			explicit guard_t(async_mutex_t* mtx = nullptr) noexcept : _mtx{ mtx }
+			{
+				//
+			}
+
+			//--------------------------------------------------------------------
+			guard_t(guard_t&& other) noexcept : _mtx{ std::exchange(other._mtx, nullptr) }
+			{
+				//
+			}
+
+			//--------------------------------------------------------------------
+			guard_t& operator = (guard_t&& other) noexcept
+			{
+				if (this != &other)
+				{
+					unlock();
+					_mtx = std::exchange(other._mtx, nullptr);
+				}
+
+				return *this;
+
+			}
+
+			//--------------------------------------------------------------------
+			~guard_t()
+			{
+				unlock();
+			}
+
+			//--------------------------------------------------------------------
+			bool owns_lock(void) const noexcept
+			{
+				return _mtx != nullptr;
+			}
+
+			//--------------------------------------------------------------------
+			explicit operator bool() const noexcept
+			{
+				return owns_lock();
+			}
+
+			//--------------------------------------------------------------------
+			void unlock(void)
+			{
+				if (auto mtx = std::exchange(_mtx, nullptr))
+					mtx->unlock();
+			}
+
+			//--------------------------------------------------------------------
+
+		private:
+			async_mutex_t*						_mtx;
+
+		};
+
+		//--------------------------------------------------------------------
+		class lock_awaiter_t : public sync_awaiter_t<async_semaphore_t>
+		{
+		public:
+			//--------------------------------------------------------------------
+			explicit lock_awaiter_t(async_mutex_t* mtx) noexcept :
+				sync_awaiter_t<async_semaphore_t>{ mtx }
+			{
+				//
+			}
+
+			//--------------------------------------------------------------------
+			guard_t await_resume(void) noexcept
+			{
+				if (sync_awaiter_t<async_semaphore_t>::await_resume())
+					return guard_t{ static_cast<async_mutex_t*>(_primitive) };
+
+				return guard_t{};
+			}
+
+			//--------------------------------------------------------------------
+
+		};
+
+		//--------------------------------------------------------------------
+		async_mutex_t(void) noexcept :
+			async_semaphore_t{ 1 }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		[[nodiscard]]
+		lock_awaiter_t lock(void) noexcept
+		{
+			return lock_awaiter_t{ this };
+		}
+
+		//--------------------------------------------------------------------
+		bool try_lock(void) noexcept
+		{
+			return try_acquire();
+		}
+
+		//--------------------------------------------------------------------
+		void unlock(void)
+		{
+			release(1);
+		}
+
+		//--------------------------------------------------------------------
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	async manual-reset event, 'co_await ev.wait()' resumes once it is
+	//	set, all the waiters are resumed by one dispatch.
+	//--------------------------------------------------------------------
+	class async_event_t
+	{
+		//--------------------------------------------------------------------
+		//	friend class types.
+		//--------------------------------------------------------------------
+		friend class sync_awaiter_t<async_event_t>;
+
+		//--------------------------------------------------------------------
+
+	public:
+		//--------------------------------------------------------------------
+		explicit async_event_t(bool is_set = false) noexcept :
+			_is_set{ is_set }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		async_event_t(async_event_t const& other) = delete;
+		async_event_t& operator = (async_event_t const& other) = delete;
+
+		//--------------------------------------------------------------------
+		[[nodiscard]]
+		sync_awaiter_t<async_event_t> wait(void) noexcept
+		{
+			return sync_awaiter_t<async_event_t>{ this };
+		}
+
+		//--------------------------------------------------------------------
+		bool is_set(void) const noexcept
+		{
+			return _is_set.load(std::memory_order::acquire);
+		}
+
+		//--------------------------------------------------------------------
+		void set(void)
+		{
+			if (_is_set.exchange(true, std::memory_order::acq_rel))
+				return;
+
+			BWorkBatch batch;
+			_waiters.lock();
+
+			while (auto waiter = _waiters.pop_front())
+				batch.add(waiter->_h);
+
+			_waiters.unlock();
+
+			if (!batch.empty())
+				BJobScheduler::dispatch(batch);
+
+		}
+
+		//--------------------------------------------------------------------
+		void reset(void) noexcept
+		{
+			_is_set.store(false, std::memory_order::relaxed);
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		bool try_wait(void) const noexcept
+		{
+			return is_set();
+		}
+
+		//--------------------------------------------------------------------
+		//	'set()' takes the lock after setting, thus either it is seen set
+		//	here or the waiter is queued before it is drained.
+		//--------------------------------------------------------------------
+		bool enqueue(sync_waiter_t* waiter) noexcept
+		{
+			_waiters.lock();
+
+			if (is_set())
+			{
+				_waiters.unlock();
+				return false;
+			}
+
+			_waiters.push_back(waiter);
+			_waiters.unlock();
+
+			return true;
+
+		}
+
+		//--------------------------------------------------------------------
+		void cancel(sync_waiter_t* waiter, BWorkBatch& batch) noexcept
+		{
+			_waiters.lock();
+			_waiters.cancel(waiter, batch);
+			_waiters.unlock();
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		std::atomic<bool>						_is_set;
+		sync_list_t								_waiters;
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	async single-use latch, the waiters are resumed once it is counted
+	//	down to zero.
+	//--------------------------------------------------------------------
+	class async_latch_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		explicit async_latch_t(std::ptrdiff_t count) noexcept :
+			_count{ count }, _event{ count <= 0 }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		async_latch_t(async_latch_t const& other) = delete;
+		async_latch_t& operator = (async_latch_t const& other) = delete;
+
+		//--------------------------------------------------------------------
+		[[nodiscard]]
+		sync_awaiter_t<async_event_t> wait(void) noexcept
+		{
+			return _event.wait();
+		}
+
+		//--------------------------------------------------------------------
+		bool try_wait(void) const noexcept
+		{
+			return _event.is_set();
+		}
+
+		//--------------------------------------------------------------------
+		void count_down(std::ptrdiff_t n = 1)
+		{
+			if (_count.fetch_sub(n, std::memory_order::acq_rel) == n)
+				_event.set();
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		std::atomic<std::ptrdiff_t>				_count;
+		async_event_t							_event;
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	async multi-producer / multi-consumer channel.
+	//	* the values go through a bounded lock-free MPMC ring (Vyukov), an
+	//	  unbounded channel spills into a locked overflow list once the
+	//	  ring is full, in FIFO order per producer.
+	//	* 'co_await send(v)' waits while a bounded channel is full and
+	//	  'co_await receive()' while it is empty. the waiters are matched
+	//	  with the values under the lock of their list, and resumed through
+	//	  the scheduler's dispatch.
+	//	* once closed, sending fails and receiving drains what is left.
+	//--------------------------------------------------------------------
+	template <typename T>
+	class channel_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		//	resumes with the value, or std::nullopt if closed and drained,
+		//	or canceled.
+		//--------------------------------------------------------------------
+		class receive_awaiter_t : public sync_awaiter_base_t
+		{
+		public:
+			//--------------------------------------------------------------------
+			explicit receive_awaiter_t(channel_t* channel) noexcept :
+				_channel{ channel }
+			{
+				//
+			}
+
+			//--------------------------------------------------------------------
+			bool await_ready(void)
+			{
+				_value = _channel->try_receive();
+				return _value || _channel->is_closed();
+			}
+
+			//--------------------------------------------------------------------
+			bool await_suspend(std::coroutine_handle<> h)
+			{
+				return suspend(h, &channel_t::cancel_receiver, [this] { return _channel->enqueue_receiver(this); });
+			}
+
+			//--------------------------------------------------------------------
+			std::optional<T> await_resume(void)
+			{
+				unlink();
+				return std::move(_value);
+			}
+
+			//--------------------------------------------------------------------
+
+		public:
+			channel_t*							_channel;
+			std::optional<T>					_value;
+
+		};
+
+		//--------------------------------------------------------------------
+		//	waits for one value at least, resumes with how many were moved
+		//	into the span, 0 if closed and drained, or canceled.
+		//--------------------------------------------------------------------
+		class receive_many_awaiter_t : public receive_awaiter_t
+		{
+		public:
+			//--------------------------------------------------------------------
+			receive_many_awaiter_t(channel_t* channel, std::span<T> values) noexcept :
+				receive_awaiter_t{ channel }, _values{ values }
+			{
+				//
+			}
+
+			//--------------------------------------------------------------------
+			bool await_ready(void)
+			{
+				_count = this->_channel->try_receive_many(_values);
+				return _count || _values.empty() || this->_channel->is_closed();
+			}
+
+			//--------------------------------------------------------------------
+			std::size_t await_resume(void)
+			{
+				if (auto value = receive_awaiter_t::await_resume())
+				{
+					_values[0] = std::move(*value);
+					_count = 1u + this->_channel->try_receive_many(_values.subspan(1u));
+				}
+
+				return _count;
+			}
+
+			//--------------------------------------------------------------------
+
+		private:
+			std::span<T>						_values;
+			std::size_t							_count{ 0u };
+
+		};
+
+		//--------------------------------------------------------------------
+		//	resumes with true if sent, false if closed or canceled.
+		//--------------------------------------------------------------------
+		class send_awaiter_t : public sync_awaiter_base_t
+		{
+		public:
+			//--------------------------------------------------------------------
+			template <typename U>
+			send_awaiter_t(channel_t* channel, U&& value) :
+				_channel{ channel }, _value{ std::forward<U>(value) }
+			{
+				//
+			}
+
+			//--------------------------------------------------------------------
+			bool await_ready(void)
+			{
+				if (_channel->is_closed())
+					return true;
+
+				_is_sent = _channel->try_send(*_value);
+				return _is_sent;
+			}
+
+			//--------------------------------------------------------------------
+			bool await_suspend(std::coroutine_handle<> h)
+			{
+				return suspend(h, &channel_t::cancel_sender, [this] { return _channel->enqueue_sender(this); });
+			}
+
+			//--------------------------------------------------------------------
+			bool await_resume(void) noexcept
+			{
+				unlink();
+				return _is_sent;
+			}
+
+			//--------------------------------------------------------------------
+
+		public:
+			channel_t*							_channel;
+			std::optional<T>					_value;
+			bool								_is_sent{ false };
+
+		};
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		class cell_t
+		{
+		public:
+			std::atomic<std::size_t>			_seq{ 0u };
+			std::optional<T>					_value;
+
+		};
+
+		//--------------------------------------------------------------------
+
+	public:
+		//--------------------------------------------------------------------
+		//	unbounded, the ring of 'ring_size' spills into the overflow list.
+		//--------------------------------------------------------------------
+		channel_t(void) :
+			channel_t{ 1024u, false }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		//	bounded, 'capacity' is rounded up to a power of two.
+		//--------------------------------------------------------------------
+		explicit channel_t(std::size_t capacity) :
+			channel_t{ capacity, true }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		channel_t(channel_t const& other) = delete;
+		channel_t& operator = (channel_t const& other) = delete;
+
+		//--------------------------------------------------------------------
+		template <typename U = T>
+		[[nodiscard]]
+		send_awaiter_t send(U&& value)
+		{
+			return { this, std::forward<U>(value) };
+		}
+
+		//--------------------------------------------------------------------
+		[[nodiscard]]
+		receive_awaiter_t receive(void) noexcept
+		{
+			return receive_awaiter_t{ this };
+		}
+
+		//--------------------------------------------------------------------
+		[[nodiscard]]
+		receive_many_awaiter_t receive_many(std::span<T> values) noexcept
+		{
+			return { this, values };
+		}
 
-        //--------------------------------------------------------------------
-		template <typename P>
-        auto& await_transform(async_action_base_t<P> const& awaiter)
-        {
-            _async_data->_next = awaiter._async_data;
-            return awaiter;
-        }
+		//--------------------------------------------------------------------
+		//	never waits, the value is moved from only if sent.
+		//--------------------------------------------------------------------
+		bool try_send(T& value)
+		{
+			if (is_closed() || !push(value))
+				return false;
 
-        //--------------------------------------------------------------------
-        template <typename U, typename P>
-        auto await_transform(async_operation_base_t<U, P>&& awaiter) noexcept
-        {
-            _async_data->_next = awaiter._async_data;
-            return awaiter;
-        }
+			notify();
+			return true;
+		}
 
-        //--------------------------------------------------------------------
-		template <typename U, typename P>
-        auto& await_transform(async_operation_base_t<U, P> const& awaiter)
-        {
-            _async_data->_next = awaiter._async_data;
-            return awaiter;
-        }
+		//--------------------------------------------------------------------
+		bool try_send(T&& value)
+		{
+			return try_send(value);
+		}
 
-        //--------------------------------------------------------------------
-        template <typename P>
-        auto await_transform(progress_reporter_base_t<P>&& awaiter) noexcept
-        {
-            return awaiter;
-        }
+		//--------------------------------------------------------------------
+		std::optional<T> try_receive(void)
+		{
+			auto value = pop();
+			if (value)
+				notify();
 
-        //--------------------------------------------------------------------
-        template <typename P>
-        auto& await_transform(progress_reporter_base_t<P> const& awaiter)
-        {
-            return awaiter;
-        }
+			return value;
+		}
 
-        //--------------------------------------------------------------------
-        template <typename U>
-        auto& await_transform(std::future<U> const& future)
-        {
-            return future;
-        }
-        
-        //--------------------------------------------------------------------
-        template <typename U>
-        auto await_transform(std::future<U>&& future) noexcept
-        {
-            return future;
-        }
-        
-        //--------------------------------------------------------------------
-        std::shared_ptr<AsyncDataType<T>>                       _async_data;
+		//--------------------------------------------------------------------
+		std::size_t try_receive_many(std::span<T> values)
+		{
+			std::size_t count = 0u;
+			for (; count < values.size(); ++count)
+			{
+				auto value = pop();
+				if (!value)
+					break;
 
-        //--------------------------------------------------------------------
+				values[count] = std::move(*value);
+			}
 
-    };
+			if (count)
+				notify();
 
+			return count;
+		}
 
-	//--------------------------------------------------------------------
-	//	promise definition for async action.
-	//--------------------------------------------------------------------
-	template <typename Progress>
-	class async_action_promise_t : 
-		public promise_base_t<void, async_action_promise_t<Progress>, Progress>
-	{
-	public:
 		//--------------------------------------------------------------------
-		async_action_t<Progress> get_return_object(void)
+		//	the waiting senders fail, the waiting receivers get what is left.
+		//--------------------------------------------------------------------
+		void close(void)
 		{
-			this->_async_data = std::make_shared<AsyncDataType<>>();
-            async_action_t<Progress> action = {
-                std::coroutine_handle<async_action_promise_t>::from_promise(*this),
-				this->_async_data };
+			if (_is_closed.exchange(true, std::memory_order::acq_rel))
+				return;
 
-			// initialize the progress data.
-            this->init_progress(static_cast<async_progress_base_t<Progress>*>(&action));
+			BWorkBatch batch;
+
+			_receivers.lock();
+			while (auto waiter = _receivers.pop_front())
+			{
+				static_cast<receive_awaiter_t*>(waiter)->_value = pop();
+				batch.add(waiter->_h);
+			}
+
+			_receiving.store(0u, std::memory_order::relaxed);
+			_receivers.unlock();
+
+			_senders.lock();
+			while (auto waiter = _senders.pop_front())
+				batch.add(waiter->_h);
+
+			_sending.store(0u, std::memory_order::relaxed);
+			_senders.unlock();
+
+			if (!batch.empty())
+				BJobScheduler::dispatch(batch);
 
-            return action;
 		}
 
 		//--------------------------------------------------------------------
-		constexpr std::suspend_never initial_suspend(void) const noexcept
+		bool is_closed(void) const noexcept
 		{
-			return {};
+			return _is_closed.load(std::memory_order::acquire);
 		}
 
 		//--------------------------------------------------------------------
-		constexpr std::suspend_never final_suspend(void) const noexcept
+
+	private:
+		//--------------------------------------------------------------------
+		channel_t(std::size_t capacity, bool is_bounded) :
+			_cells{ std::make_unique<cell_t[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2u))) },
+			_mask{ std::bit_ceil(std::max<std::size_t>(capacity, 2u)) - 1u },
+			_is_bounded{ is_bounded }
 		{
-			return {};
+			for (std::size_t i = 0u; i <= _mask; ++i)
+				_cells[i]._seq.store(i, std::memory_order::relaxed);
 		}
 
 		//--------------------------------------------------------------------
-		void return_void(void)
+		bool try_push(T& value)
 		{
-			if (this->_async_data)
-			{
-				std::unique_lock lck{ this->_async_data->_mx };
-				this->_async_data->_is_ready = true;
+			auto pos = _tail.load(std::memory_order::relaxed);
 
-				// notify the current waiter.
-				this->_async_data->_cv.notify_all();
+			while (true)
+			{
+				auto& cell = _cells[pos & _mask];
+				auto seq = cell._seq.load(std::memory_order::acquire);
+				auto diff = static_cast<std::ptrdiff_t>(seq - pos);
 
-				// resume the outer awaiter if it exists.
-				if (this->_async_data->_h)
+				if (!diff)
 				{
-					this->_async_data->_h.resume();
+					if (_tail.compare_exchange_weak(pos, pos + 1u, std::memory_order::relaxed))
+					{
+						cell._value.emplace(std::move(value));
+						cell._seq.store(pos + 1u, std::memory_order::release);
+						return true;
+					}
 				}
-
+				else if (diff < 0)
+					return false;	// full.
+				else
+					pos = _tail.load(std::memory_order::relaxed);
 			}
-
 		}
 
 		//--------------------------------------------------------------------
-		void cancellation_callback(
-			std::function<void(void)> cancel_fn,
-			BJobToken tok)
+		std::optional<T> try_pop(void)
 		{
-			this->_async_data->_cancel_fn = cancel_fn;
-			this->_async_data->_cb_token = tok;
+			auto pos = _head.load(std::memory_order::relaxed);
+
+			while (true)
+			{
+				auto& cell = _cells[pos & _mask];
+				auto seq = cell._seq.load(std::memory_order::acquire);
+				auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1u));
+
+				if (!diff)
+				{
+					if (_head.compare_exchange_weak(pos, pos + 1u, std::memory_order::relaxed))
+					{
+						std::optional<T> value{ std::move(cell._value) };
+						cell._value.reset();
+						cell._seq.store(pos + _mask + 1u, std::memory_order::release);
+						return value;
+					}
+				}
+				else if (diff < 0)
+					return std::nullopt;	// empty.
+				else
+					pos = _head.load(std::memory_order::relaxed);
+			}
 		}
 
 		//--------------------------------------------------------------------
-		bool enable_cancellation_propagation(bool val) const
+		//	once overflowed, the values go after the ones queued before.
+		//--------------------------------------------------------------------
+		bool push(T& value)
 		{
-			auto ret = this->_async_data->_cancellation_propagation;
-			this->_async_data->_cancellation_propagation = val;
+			if (_is_bounded)
+				return try_push(value);
+
+			if (_is_overflowed.load(std::memory_order::acquire) || !try_push(value))
+			{
+				std::unique_lock lck(_overflow_mx);
+				_overflow.push_back(std::move(value));
+				_is_overflowed.store(true, std::memory_order::release);
+			}
 
-			return ret;
+			return true;
 		}
 
 		//--------------------------------------------------------------------
-		[[noreturn]]
-		void unhandled_exception(void)
+		std::optional<T> pop(void)
 		{
-			throw;
+			auto value = try_pop();
+			if (value || !_is_overflowed.load(std::memory_order::acquire))
+				return value;
+
+			std::unique_lock lck(_overflow_mx);
+			if (!_overflow.empty())
+			{
+				value.emplace(std::move(_overflow.front()));
+				_overflow.pop_front();
+			}
+
+			if (_overflow.empty())
+				_is_overflowed.store(false, std::memory_order::release);
+
+			return value;
 		}
 
 		//--------------------------------------------------------------------
-		std::coroutine_handle<>					_h;
+		//	a waiter registers, then checks again, and a value is pushed
+		//	(or popped), then the waiters are checked, the fences order the
+		//	two on both sides.
+		//--------------------------------------------------------------------
+		bool enqueue_receiver(receive_awaiter_t* waiter)
+		{
+			_receivers.lock();
 
+			if (!(waiter->_value = pop()) && !is_closed())
+			{
+				_receivers.push_back(waiter);
+				_receiving.fetch_add(1u, std::memory_order::relaxed);
+				std::atomic_thread_fence(std::memory_order::seq_cst);
 
-		//--------------------------------------------------------------------
+				if (!(waiter->_value = pop()))
+				{
+					_receivers.unlock();
+					return true;
+				}
 
+				_receivers.erase(waiter);
+				_receiving.fetch_sub(1u, std::memory_order::relaxed);
+			}
 
-	};
+			_receivers.unlock();
 
+			if (waiter->_value)
+				notify();
+
+			return false;
+
+		}
 
-	//--------------------------------------------------------------------
-	//	promise definition for async operation.
-	//--------------------------------------------------------------------
-	template <typename T, typename Progress>
-	class async_operation_promise_t : 
-		public promise_base_t<T, async_operation_promise_t<T, Progress>, Progress>
-	{
-	public:
 		//--------------------------------------------------------------------
-		async_operation_t<T, Progress> get_return_object(void)
+		bool enqueue_sender(send_awaiter_t* waiter)
 		{
-			this->_async_data = std::make_shared<AsyncDataType<T>>();
-			async_operation_t<T, Progress> action = {
-				std::coroutine_handle<async_operation_promise_t>::from_promise(*this),
-				this->_async_data };
+			_senders.lock();
 
-			// initialize the progress data.
-			this->init_progress(static_cast<async_progress_base_t<Progress>*>(&action));
+			if (!is_closed() && !(waiter->_is_sent = push(*waiter->_value)))
+			{
+				_senders.push_back(waiter);
+				_sending.fetch_add(1u, std::memory_order::relaxed);
+				std::atomic_thread_fence(std::memory_order::seq_cst);
 
-			return action;
+				if (!(waiter->_is_sent = push(*waiter->_value)))
+				{
+					_senders.unlock();
+					return true;
+				}
+
+				_senders.erase(waiter);
+				_sending.fetch_sub(1u, std::memory_order::relaxed);
+			}
+
+			_senders.unlock();
+
+			if (waiter->_is_sent)
+				notify();
+
+			return false;
 
 		}
 
 		//--------------------------------------------------------------------
-		constexpr std::suspend_never initial_suspend(void) const noexcept
+		//	hands the values over to the waiting receivers, and the room to
+		//	the waiting senders, until neither moves.
+		//--------------------------------------------------------------------
+		void notify(void)
 		{
-			return {};
+			std::atomic_thread_fence(std::memory_order::seq_cst);
+
+			BWorkBatch batch;
+			while (match_receivers(batch) | match_senders(batch));
+
+			if (!batch.empty())
+				BJobScheduler::dispatch(batch);
+
 		}
 
 		//--------------------------------------------------------------------
-		constexpr std::suspend_never final_suspend(void) const noexcept
+		bool match_receivers(BWorkBatch& batch)
 		{
-			return {};
+			if (!_receiving.load(std::memory_order::relaxed))
+				return false;
+
+			auto is_matched = false;
+			_receivers.lock();
+
+			while (auto waiter = static_cast<receive_awaiter_t*>(_receivers.front()))
+			{
+				if (!(waiter->_value = pop()))
+					break;
+
+				_receivers.pop_front();
+				_receiving.fetch_sub(1u, std::memory_order::relaxed);
+				batch.add(waiter->_h);
+				is_matched = true;
+			}
+
+			_receivers.unlock();
+
+			return is_matched;
+
 		}
 
 		//--------------------------------------------------------------------
-		void return_value(T const& val) noexcept (std::is_nothrow_copy_constructible_v<T>)
+		bool match_senders(BWorkBatch& batch)
 		{
-			if (this->_async_data)
+			if (!_sending.load(std::memory_order::relaxed))
+				return false;
+
+			auto is_matched = false;
+			_senders.lock();
+
+			while (auto waiter = static_cast<send_awaiter_t*>(_senders.front()))
 			{
-				// set the current value.
-				this->_async_data->_val = val;
+				if (!(waiter->_is_sent = push(*waiter->_value)))
+					break;
 
-				std::unique_lock lck{ this->_async_data->_mx };
-				this->_async_data->_is_ready = true;
+				_senders.pop_front();
+				_sending.fetch_sub(1u, std::memory_order::relaxed);
+				batch.add(waiter->_h);
+				is_matched = true;
+			}
 
-				// notify the current waiter.
-				this->_async_data->_cv.notify_all();
+			_senders.unlock();
 
-				// resume the outer awaiter if it exists.
-				if (this->_async_data->_h)
-				{
-					this->_async_data->_h.resume();
-				}
+			return is_matched;
 
-			}
+		}
+
+		//--------------------------------------------------------------------
+		//	called by the cancellation with the children lock held.
+		//--------------------------------------------------------------------
+		static void cancel_receiver(sync_waiter_t* waiter, BWorkBatch& batch)
+		{
+			auto self = static_cast<receive_awaiter_t*>(waiter)->_channel;
+
+			self->_receivers.lock();
+			if (self->_receivers.cancel(waiter, batch))
+				self->_receiving.fetch_sub(1u, std::memory_order::relaxed);
+
+			self->_receivers.unlock();
 
 		}
 
 		//--------------------------------------------------------------------
-		void return_value(T&& val) noexcept(std::is_nothrow_move_constructible_v<T>)
+		static void cancel_sender(sync_waiter_t* waiter, BWorkBatch& batch)
 		{
-			if (this->_async_data)
-			{
-				// set the current value.
-				this->_async_data->_val = std::move(val);
+			auto self = static_cast<send_awaiter_t*>(waiter)->_channel;
 
-				std::unique_lock lck{ this->_async_data->_mx };
-				this->_async_data->_is_ready = true;
+			self->_senders.lock();
+			if (self->_senders.cancel(waiter, batch))
+				self->_sending.fetch_sub(1u, std::memory_order::relaxed);
 
-				// notify the current waiter.
-				this->_async_data->_cv.notify_all();
+			self->_senders.unlock();
 
-				// resume the outer awaiter if it exists.
-				if (this->_async_data->_h)
-				{
-					this->_async_data->_h.resume();
-				}
+		}
 
-			}
+		//--------------------------------------------------------------------
+
+	private:
+		std::unique_ptr<cell_t[]>				_cells;
+		std::size_t								_mask;
+		alignas(64) std::atomic<std::size_t>	_tail{ 0u };
+		alignas(64) std::atomic<std::size_t>	_head{ 0u };
+		alignas(64) bool						_is_bounded;
+		std::atomic<bool>						_is_closed{ false };
+		std::atomic<bool>						_is_overflowed{ false };
+		std::mutex								_overflow_mx;
+		std::deque<T>							_overflow;
+		sync_list_t								_receivers;
+		sync_list_t								_senders;
+		std::atomic<std::size_t>				_receiving{ 0u };	// the queued receivers.
+		std::atomic<std::size_t>				_sending{ 0u };		// the queued senders.
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	awaits one request of the I/O reactor, resumes with the bytes
+	//	transferred, or -errno.
+	//	* the completion resumes the coroutine through the scheduler's
+	//	  dispatch, no thread waits for the I/O.
+	//	* a canceled coroutine cancels the request in flight, which then
+	//	  resumes with -ECANCELED unless done already.
+	//--------------------------------------------------------------------
+	class io_awaiter_t : public sync_awaiter_base_t, public BIoRequest
+	{
+	public:
+		//--------------------------------------------------------------------
+		//	at most the bytes which one read / write of Linux transfers.
+		//--------------------------------------------------------------------
+		io_awaiter_t(BIoOp op, int fd, void* buf, std::size_t len, std::uint64_t offset, unsigned buf_index = 0u) noexcept
+		{
+			_op = op;
+			_fd = fd;
+			_buf = buf;
+			_len = static_cast<unsigned>(std::min<std::size_t>(len, 0x7ffff000u));
+			_offset = offset;
+			_buf_index = buf_index;
+			_complete = &on_complete;
 		}
 
 		//--------------------------------------------------------------------
-		void cancellation_callback(
-			std::function<void(void)> cancel_fn,
-			BJobToken tok)
+		bool await_ready(void) const noexcept
 		{
-			this->_async_data->_cancel_fn = cancel_fn;
-			this->_async_data->_cb_token = tok;
+			return false;
 		}
 
 		//--------------------------------------------------------------------
-		bool enable_cancellation_propagation(bool val) const
+		bool await_suspend(std::coroutine_handle<> h)
 		{
-			auto ret = this->_async_data->_cancellation_propagation;
-			this->_async_data->_cancellation_propagation = val;
-			return ret;
+			return suspend(h, &on_cancel, [this]
+				{
+					auto ret = BIoReactor::instance()->submit(this);
+					if (ret < 0)
+						_result = ret;
+
+					return ret == 0;
+				});
 		}
 
 		//--------------------------------------------------------------------
-		[[noreturn]]
-		void unhandled_exception(void)
+		int await_resume(void) noexcept
 		{
-			throw;
+			unlink();
+			return _is_canceled ? -ECANCELED : _result;
 		}
 
 		//--------------------------------------------------------------------
-		std::coroutine_handle<>				    _h;
 
+	private:
+		//--------------------------------------------------------------------
+		static void on_complete(BIoRequest* req, BWorkBatch& batch)
+		{
+			batch.add(static_cast<io_awaiter_t*>(req)->_h);
+		}
 
 		//--------------------------------------------------------------------
+		//	called by the cancellation with the children lock held, while
+		//	the request is in flight. submitting may enter the kernel, thus
+		//	it goes to the batch run after unlocking, by the tag only.
+		//--------------------------------------------------------------------
+		static void on_cancel(sync_waiter_t* waiter, BWorkBatch& batch)
+		{
+			batch.add([tag = static_cast<io_awaiter_t*>(waiter)->_tag]
+				{
+					BIoReactor::instance()->cancel(tag);
+				});
+		}
 
+		//--------------------------------------------------------------------
 
 	};
 
@@ -1467,8 +5352,7 @@ operator co_await(agave::details::progress_reporter_base_t<P> const& async)
 
 //--------------------------------------------------------------------
 //  overload co_await to allow co_await'ing std::future<T> and
-//  std::future<void> by naively spawning a new thread for each
-//  co_await.
+//  std::future<void>, polled by the job scheduler.
 //--------------------------------------------------------------------
 template<typename T>
 inline
@@ -1476,41 +5360,7 @@ auto
 operator co_await(std::future<T> future) noexcept
 	requires(!std::is_reference_v<T>)
 {
-	//--------------------------------------------------------------------
-	class fut_awaiter : public std::future<T>
-	{
-	public:
-		//--------------------------------------------------------------------
-		bool await_ready() const noexcept
-		{
-			using namespace std::chrono_literals;
-            
-			return this->wait_for(0ms) != std::future_status::timeout;
-		}
-
-		//--------------------------------------------------------------------
-		void await_suspend(std::coroutine_handle<> h) const
-		{
-			std::thread([this, h]
-				{
-					this->wait();
-					h();
-				}).detach();
-            
-		}
-
-		//--------------------------------------------------------------------
-		T await_resume() { return this->get(); }
-
-		//--------------------------------------------------------------------
-
-	};
-
-	//--------------------------------------------------------------------
-	return fut_awaiter{ std::move(future) };
-
-	//--------------------------------------------------------------------
-
+	return agave::details::future_awaiter_t<T>{ std::move(future) };
 }
 
 
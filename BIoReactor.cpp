@@ -0,0 +1,843 @@
+//--------------------------------------------------------------------
+//	BIoReactor.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	I/O Reactor - A Part of Agave(TM) Coroutine Framework 
+//		(based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "BIoReactor.h"
+#include "BJobScheduler.h"
+#include "BThreadPool.h"
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <exception>
+#include <cerrno>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define _BIO_URING__
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <poll.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+
+//--------------------------------------------------------------------
+// initialize static variables.
+//--------------------------------------------------------------------
+constinit std::shared_ptr<agave::details::BIoReactor> agave::details::BIoReactor::_b_io_reactor{ nullptr };
+constinit std::atomic<agave::details::BIoReactor*> agave::details::BIoReactor::_instance{ nullptr };
+std::mutex agave::details::BIoReactor::_instance_mx;
+constinit bool agave::details::BIoReactor::_is_closed{ false };
+constinit unsigned agave::details::BIoReactor::_entries{ 256u };
+
+
+//--------------------------------------------------------------------
+namespace agave::details
+{
+	//--------------------------------------------------------------------
+	//	the tags are (generation << 48 | address of the request), the
+	//	generation tells a request from a later one at the same address.
+	//	0 is never a request.
+	//--------------------------------------------------------------------
+	static constexpr std::uint64_t						__tag_ignored{ 0u };	// completions of the cancellations.
+	static constexpr std::uint64_t						__tag_address_mask{ (1ull << 48) - 1ull };
+
+	//--------------------------------------------------------------------
+	//	the depth of begin_batch() on the current thread.
+	//--------------------------------------------------------------------
+	static thread_local unsigned						__tls_batch_depth{ 0u };
+
+
+	//--------------------------------------------------------------------
+
+
+}
+
+
+//--------------------------------------------------------------------
+//	the rings shared with the kernel, the heads and tails are published
+//	by acquire / release.
+//--------------------------------------------------------------------
+class agave::details::BIoReactor::ring_t
+{
+public:
+	int												_fd{ -1 };
+#if defined(_BIO_URING__)
+	void*											_sq_ptr{ MAP_FAILED };
+	std::size_t										_sq_size{ 0u };
+	void*											_cq_ptr{ MAP_FAILED };
+	std::size_t										_cq_size{ 0u };
+	io_uring_sqe*									_sqes{ static_cast<io_uring_sqe*>(MAP_FAILED) };
+	std::size_t										_sqes_size{ 0u };
+	int												_wake_fd{ -1 };
+	unsigned*										_sq_flags{ nullptr };
+	unsigned*										_sq_head{ nullptr };
+	unsigned*										_sq_tail{ nullptr };
+	unsigned										_sq_mask{ 0u };
+	unsigned										_sq_entries{ 0u };
+	unsigned*										_cq_head{ nullptr };
+	unsigned*										_cq_tail{ nullptr };
+	unsigned										_cq_mask{ 0u };
+	io_uring_cqe*									_cqes{ nullptr };
+#endif
+
+	//--------------------------------------------------------------------
+	~ring_t(void)
+	{
+		close();
+	}
+
+	//--------------------------------------------------------------------
+	//	leaves '_fd' at -1 if the kernel refuses it.
+	//--------------------------------------------------------------------
+	void open(unsigned entries)
+	{
+#if defined(_BIO_URING__)
+		io_uring_params params{};
+		params.flags = IORING_SETUP_CLAMP;
+
+		_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+		if (_fd < 0)
+			return;
+
+		_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+			_sq_size = _cq_size = std::max(_sq_size, _cq_size);
+
+		_sq_ptr = ::mmap(nullptr, _sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+		_cq_ptr = (params.features & IORING_FEAT_SINGLE_MMAP) ? _sq_ptr :
+			::mmap(nullptr, _cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+
+		_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+		_sqes = static_cast<io_uring_sqe*>(
+			::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES));
+
+		_wake_fd = ::eventfd(0u, EFD_CLOEXEC);
+
+		if (_sq_ptr == MAP_FAILED || _cq_ptr == MAP_FAILED || _sqes == MAP_FAILED || _wake_fd < 0)
+		{
+			close();
+			return;
+		}
+
+		auto sq = static_cast<char*>(_sq_ptr);
+		_sq_flags = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+		_sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+		_sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		_sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+		_sq_entries = params.sq_entries;
+
+		// the entry at each index of the ring is the one of the same index.
+		auto sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+		for (unsigned i = 0u; i < _sq_entries; ++i)
+			sq_array[i] = i;
+
+		auto cq = static_cast<char*>(_cq_ptr);
+		_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+		_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+#else
+		(void)entries;
+#endif
+	}
+
+	//--------------------------------------------------------------------
+	void close(void)
+	{
+#if defined(_BIO_URING__)
+		if (_sqes != MAP_FAILED)
+			::munmap(_sqes, _sqes_size);
+
+		if (_cq_ptr != MAP_FAILED && _cq_ptr != _sq_ptr)
+			::munmap(_cq_ptr, _cq_size);
+
+		if (_sq_ptr != MAP_FAILED)
+			::munmap(_sq_ptr, _sq_size);
+
+		if (_fd >= 0)
+			::close(_fd);
+
+		if (_wake_fd >= 0)
+			::close(_wake_fd);
+
+		_wake_fd = -1;
+		_sq_ptr = _cq_ptr = MAP_FAILED;
+		_sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+#endif
+		_fd = -1;
+	}
+
+#if defined(_BIO_URING__)
+	//--------------------------------------------------------------------
+	//	the next free entry, cleared, or nullptr if the ring is full.
+	//	called with the submission lock held.
+	//--------------------------------------------------------------------
+	io_uring_sqe* next_sqe(void) noexcept
+	{
+		auto head = std::atomic_ref<unsigned>(*_sq_head).load(std::memory_order::acquire);
+		auto tail = *_sq_tail;
+
+		if (tail - head >= _sq_entries)
+			return nullptr;
+
+		auto sqe = &_sqes[tail & _sq_mask];
+		*sqe = io_uring_sqe{};
+
+		return sqe;
+
+	}
+
+	//--------------------------------------------------------------------
+	//	publishes the entry filled after next_sqe().
+	//--------------------------------------------------------------------
+	void push_sqe(void) noexcept
+	{
+		std::atomic_ref<unsigned>(*_sq_tail).store(*_sq_tail + 1u, std::memory_order::release);
+	}
+
+	//--------------------------------------------------------------------
+	//	takes back the entries not consumed by the kernel, passing their
+	//	tags to 'f'. called with the submission lock held, by the one
+	//	submitting, thus no one enters the kernel meanwhile.
+	//--------------------------------------------------------------------
+	template <typename F>
+	void take_back(F const& f)
+	{
+		auto head = std::atomic_ref<unsigned>(*_sq_head).load(std::memory_order::acquire);
+		for (auto i = head; i != *_sq_tail; ++i)
+			f(_sqes[i & _sq_mask].user_data);
+
+		std::atomic_ref<unsigned>(*_sq_tail).store(head, std::memory_order::release);
+	}
+
+	//--------------------------------------------------------------------
+	//	returns the entries consumed, or -errno.
+	//--------------------------------------------------------------------
+	int enter(unsigned to_submit, unsigned min_complete, unsigned flags) noexcept
+	{
+		auto ret = ::syscall(__NR_io_uring_enter, _fd, to_submit, min_complete, flags, nullptr, 0);
+		return ret < 0 ? -errno : static_cast<int>(ret);
+	}
+
+	//--------------------------------------------------------------------
+	//	waits for a completion, or for wake(), returns 0, or -errno if the
+	//	ring fails. the completions the ring overflowed are flushed back
+	//	into it, the ring fd does not poll them.
+	//--------------------------------------------------------------------
+	int wait(void) noexcept
+	{
+		pollfd fds[2]{ { _fd, POLLIN, 0 }, { _wake_fd, POLLIN, 0 } };
+		if (::poll(fds, 2u, -1) < 0)
+			return errno == EINTR || errno == ENOMEM ? 0 : -errno;
+
+		if ((fds[0].revents | fds[1].revents) & POLLNVAL)
+			return -EBADF;
+
+		if (fds[1].revents & POLLIN)
+		{
+			eventfd_t value;
+			(void)::eventfd_read(_wake_fd, &value);
+		}
+
+		if (std::atomic_ref<unsigned>(*_sq_flags).load(std::memory_order::relaxed) & IORING_SQ_CQ_OVERFLOW)
+		{
+			auto ret = enter(0u, 0u, IORING_ENTER_GETEVENTS);
+			if (ret < 0 && ret != -EINTR && ret != -EAGAIN && ret != -EBUSY)
+				return ret;
+		}
+
+		return 0;
+
+	}
+
+	//--------------------------------------------------------------------
+	void wake(void) noexcept
+	{
+		(void)::eventfd_write(_wake_fd, 1u);
+	}
+#endif
+
+};
+
+
+//--------------------------------------------------------------------
+//	made on first use, and made again after destroy_instance(), but
+//	not while the instance is destroyed, nor once the statics are.
+//--------------------------------------------------------------------
+auto
+agave::details::BIoReactor::instance_ptr(void) ->
+std::shared_ptr<agave::details::BIoReactor>
+{
+	std::unique_lock lck{ _instance_mx };
+	if (!_b_io_reactor && !_is_closed)
+	{
+		_b_io_reactor = espresso::utilities::make_obj<BIoReactor>(
+			&BIoReactor::delete_self, _entries);
+		_instance.store(_b_io_reactor.get(), std::memory_order::release);
+	}
+
+	return _b_io_reactor;
+
+}
+
+
+//--------------------------------------------------------------------
+//	the raw pointer, without touching the reference count, 'nullptr'
+//	when instance_ptr() makes none.
+//--------------------------------------------------------------------
+auto
+agave::details::BIoReactor::instance(void) ->
+agave::details::BIoReactor*
+{
+	if (auto p = _instance.load(std::memory_order::acquire))
+		return p;
+
+	return instance_ptr().get();
+
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BIoReactor::destroy_instance(void)
+{
+	std::unique_lock lck(_instance_mx);
+	auto p = std::exchange(_b_io_reactor, nullptr);
+	_instance.store(nullptr, std::memory_order::release);
+	_is_closed = true;
+	lck.unlock();
+
+	// destroyed without the lock, the calls meanwhile get no instance,
+	// rather than a new one.
+	p = nullptr;
+
+	lck.lock();
+	_is_closed = false;
+
+}
+
+
+//--------------------------------------------------------------------
+//	the size of the submission queue, rounded up to a power of two by
+//	the kernel. it takes effect when the instance is created, returns
+//	false if the current instance still uses the previous one.
+//--------------------------------------------------------------------
+bool
+agave::details::BIoReactor::select_entries(unsigned count)
+{
+	std::unique_lock lck(_instance_mx);
+	_entries = std::clamp(count, 1u, 32768u);
+
+	return !_b_io_reactor;
+
+}
+
+
+//--------------------------------------------------------------------
+bool
+agave::details::BIoReactor::is_available(void) const noexcept
+{
+	return _ring->_fd >= 0;
+}
+
+
+//--------------------------------------------------------------------
+//	fills the next entry by 'fill(sqe)' under the lock. the submitter
+//	which finds nobody submitting enters the kernel until no entry is
+//	left, the others leave theirs to it, thus one thread at a time
+//	submits. returns 0, or the hard error of the ring, not filling.
+//--------------------------------------------------------------------
+template <typename Fill>
+int
+agave::details::BIoReactor::queue(Fill const& fill)
+{
+#if defined(_BIO_URING__)
+	std::unique_lock lck(_sq_mx);
+
+	auto sqe = _ring->next_sqe();
+	while (!sqe && !_error)
+	{
+		// full, the kernel consumes the queued entries at once, by this
+		// thread unless another one is submitting already.
+		if (_is_submitting)
+		{
+			lck.unlock();
+			std::this_thread::yield();
+			lck.lock();
+		}
+		else
+		{
+			_is_submitting = true;
+			flush(lck);
+			_is_submitting = false;
+		}
+
+		sqe = _ring->next_sqe();
+	}
+
+	if (_error)
+		return _error;
+
+	fill(sqe);
+
+	_ring->push_sqe();
+	++_unsubmitted;
+
+	if (_is_submitting || __tls_batch_depth)
+		return 0;
+
+	_is_submitting = true;
+	while (_unsubmitted)
+		flush(lck);
+
+	_is_submitting = false;
+
+	return 0;
+#else
+	(void)fill;
+	return -ENOSYS;
+#endif
+
+}
+
+
+//--------------------------------------------------------------------
+//	queues the request, returns 0, or -errno if it is not queued. it may
+//	complete on the completion thread before this returns.
+//--------------------------------------------------------------------
+int
+agave::details::BIoReactor::submit(BIoRequest* req)
+{
+#if defined(_BIO_URING__)
+	if (!is_available())
+		return -ENOSYS;
+
+	static constexpr unsigned char opcodes[]{
+		IORING_OP_READ,
+		IORING_OP_WRITE,
+		IORING_OP_READ_FIXED,
+		IORING_OP_WRITE_FIXED,
+		IORING_OP_FSYNC,
+		IORING_OP_FSYNC,
+	};
+
+	auto gen = _next_tag.fetch_add(1u, std::memory_order::relaxed) & 0xffffull;
+	req->_tag = (gen << 48) | reinterpret_cast<std::uintptr_t>(req);
+
+	return queue([this, req](io_uring_sqe* sqe)
+		{
+			link(req);
+
+			sqe->opcode = opcodes[static_cast<unsigned>(req->_op)];
+			sqe->fd = req->_fd;
+			sqe->user_data = req->_tag;
+
+			if (req->_op == BIoOp::fsync || req->_op == BIoOp::fdatasync)
+				sqe->fsync_flags = req->_op == BIoOp::fdatasync ? IORING_FSYNC_DATASYNC : 0u;
+			else
+			{
+				sqe->addr = reinterpret_cast<std::uintptr_t>(req->_buf);
+				sqe->len = req->_len;
+				sqe->off = req->_offset;
+				sqe->buf_index = static_cast<decltype(sqe->buf_index)>(req->_buf_index);
+			}
+
+		});
+#else
+	(void)req;
+	return -ENOSYS;
+#endif
+
+}
+
+
+//--------------------------------------------------------------------
+//	the request of the tag completes with -ECANCELED unless it is done
+//	already, the tag of a request gone is never reused soon.
+//--------------------------------------------------------------------
+void
+agave::details::BIoReactor::cancel(std::uint64_t tag)
+{
+#if defined(_BIO_URING__)
+	if (!is_available())
+		return;
+
+	(void)queue([tag](io_uring_sqe* sqe)
+		{
+			sqe->opcode = IORING_OP_ASYNC_CANCEL;
+			sqe->fd = -1;
+			sqe->addr = tag;
+			sqe->user_data = __tag_ignored;
+		});
+#else
+	(void)tag;
+#endif
+
+}
+
+
+//--------------------------------------------------------------------
+//	the requests of this thread stay queued until the outermost
+//	end_batch(), which must come before waiting for any of them.
+//	returns the depth, which end_batch() is given back.
+//--------------------------------------------------------------------
+unsigned
+agave::details::BIoReactor::begin_batch(void) noexcept
+{
+	return ++__tls_batch_depth;
+}
+
+
+//--------------------------------------------------------------------
+//	the depth is not the one begun if the batch spanned a suspension,
+//	resumed on another thread, or over another batch of this thread.
+//	the depths of both threads are wrong by then, which would leave
+//	the requests queued forever, thus it terminates.
+//--------------------------------------------------------------------
+void
+agave::details::BIoReactor::end_batch(unsigned depth)
+{
+	if (depth != __tls_batch_depth)
+		std::terminate();
+
+	if (--__tls_batch_depth)
+		return;
+
+	std::unique_lock lck(_sq_mx);
+	if (_is_submitting)
+		return;
+
+	_is_submitting = true;
+	while (_unsubmitted)
+		flush(lck);
+
+	_is_submitting = false;
+
+}
+
+
+//--------------------------------------------------------------------
+//	replaces the registered buffers, the index of a buffer in the span
+//	is the '_buf_index' of the fixed reads and writes.
+//--------------------------------------------------------------------
+bool
+agave::details::BIoReactor::register_buffers(std::span<std::span<std::byte> const> buffers)
+{
+#if defined(_BIO_URING__)
+	if (!is_available() || buffers.empty())
+		return false;
+
+	std::vector<iovec> iovecs;
+	iovecs.reserve(buffers.size());
+	for (auto& buffer : buffers)
+		iovecs.push_back({ buffer.data(), buffer.size() });
+
+	unregister_buffers();
+
+	return ::syscall(__NR_io_uring_register, _ring->_fd, IORING_REGISTER_BUFFERS,
+		iovecs.data(), static_cast<unsigned>(iovecs.size())) == 0;
+#else
+	(void)buffers;
+	return false;
+#endif
+
+}
+
+
+//--------------------------------------------------------------------
+bool
+agave::details::BIoReactor::unregister_buffers(void)
+{
+#if defined(_BIO_URING__)
+	if (!is_available())
+		return false;
+
+	return ::syscall(__NR_io_uring_register, _ring->_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0u) == 0;
+#else
+	return false;
+#endif
+
+}
+
+
+//--------------------------------------------------------------------
+//	the io_uring_enter calls which submitted.
+//--------------------------------------------------------------------
+std::size_t
+agave::details::BIoReactor::submissions(void) const noexcept
+{
+	return _submissions.load(std::memory_order::relaxed);
+}
+
+
+//--------------------------------------------------------------------
+agave::details::BIoReactor::BIoReactor(unsigned entries) :
+	_ring{ std::make_unique<ring_t>() }
+{
+	_ring->open(entries);
+
+	if (is_available())
+		loop_completions();
+
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BIoReactor::delete_self(BIoReactor* p)
+{
+	if (!p)
+		return;
+
+	// still published, the static itself went away at exit.
+	std::unique_lock lck(_instance_mx);
+	if (_instance.load(std::memory_order::relaxed) == p)
+	{
+		_instance.store(nullptr, std::memory_order::release);
+		_is_closed = true;
+	}
+
+	lck.unlock();
+
+	delete p;
+
+}
+
+
+//--------------------------------------------------------------------
+//	the requests still in flight are canceled, the completion thread
+//	exits once it completed all of them.
+//--------------------------------------------------------------------
+agave::details::BIoReactor::~BIoReactor(void)
+{
+#if defined(_BIO_URING__)
+	if (!_th.joinable())
+		return;
+
+	std::vector<std::uint64_t> tags;
+
+	std::unique_lock lck(_sq_mx);
+	for (auto req = _in_flight; req; req = req->_next)
+		tags.push_back(req->_tag);
+
+	lck.unlock();
+
+	for (auto tag : tags)
+		(void)queue([tag](io_uring_sqe* sqe)
+			{
+				sqe->opcode = IORING_OP_ASYNC_CANCEL;
+				sqe->fd = -1;
+				sqe->addr = tag;
+				sqe->user_data = __tag_ignored;
+			});
+
+	// submitted even within a batch of this thread.
+	lck.lock();
+	_is_exit = true;
+	_is_submitting = true;
+
+	while (_unsubmitted)
+		flush(lck);
+
+	_is_submitting = false;
+	lck.unlock();
+
+	_ring->wake();
+	_th.join();
+#endif
+}
+
+
+//--------------------------------------------------------------------
+//	enters the kernel for the queued entries without holding the lock,
+//	the entries queued meanwhile are left to the next call. called by
+//	the one submitting only.
+//	* interrupted, or too many completions pending, the entries left
+//	  stay in the ring for the next call.
+//	* on any other error, the ring is done with. the requests still
+//	  queued are taken back and complete with it, the completion thread
+//	  fails the ones in flight once no completion may come anymore.
+//--------------------------------------------------------------------
+void
+agave::details::BIoReactor::flush(std::unique_lock<std::mutex>& lck)
+{
+#if defined(_BIO_URING__)
+	auto count = std::exchange(_unsubmitted, 0u);
+	if (!count)
+		return;
+
+	lck.unlock();
+
+	auto ret = _ring->enter(count, 0u, 0u);
+	_submissions.fetch_add(1u, std::memory_order::relaxed);
+
+	lck.lock();
+
+	if (ret >= static_cast<int>(count))
+		return;
+
+	if (ret >= 0 || ret == -EINTR || ret == -EAGAIN || ret == -EBUSY)
+	{
+		_unsubmitted += count - static_cast<unsigned>(std::max(ret, 0));
+
+		if (ret <= 0)
+		{
+			lck.unlock();
+			std::this_thread::yield();
+			lck.lock();
+		}
+
+		return;
+	}
+
+	_error = ret;
+
+	BWorkBatch batch;
+	_ring->take_back([&](std::uint64_t tag)
+		{
+			if (tag == __tag_ignored)
+				return;
+
+			auto req = reinterpret_cast<BIoRequest*>(tag & __tag_address_mask);
+			unlink(req);
+			req->_result = ret;
+			req->_complete(req, batch);
+		});
+
+	_unsubmitted = 0u;
+	_ring->wake();
+
+	if (!batch.empty())
+	{
+		lck.unlock();
+		BJobScheduler::dispatch(batch);
+		lck.lock();
+	}
+#else
+	(void)lck;
+#endif
+
+}
+
+
+//--------------------------------------------------------------------
+//	called with '_sq_mx' held.
+//--------------------------------------------------------------------
+void
+agave::details::BIoReactor::link(BIoRequest* req) noexcept
+{
+	req->_prev = nullptr;
+	req->_next = _in_flight;
+
+	if (_in_flight)
+		_in_flight->_prev = req;
+
+	_in_flight = req;
+}
+
+
+//--------------------------------------------------------------------
+//	called with '_sq_mx' held.
+//--------------------------------------------------------------------
+void
+agave::details::BIoReactor::unlink(BIoRequest* req) noexcept
+{
+	if (req->_prev)
+		req->_prev->_next = req->_next;
+	else
+		_in_flight = req->_next;
+
+	if (req->_next)
+		req->_next->_prev = req->_prev;
+
+	req->_prev = req->_next = nullptr;
+}
+
+
+//--------------------------------------------------------------------
+//	waits for the completions, or for a wakeup, then reaps all of them.
+//	* on a hard error of the ring, the requests in flight complete with
+//	  it, and the thread exits.
+//	* told to exit, it exits once no request is in flight, or at once
+//	  failing them if the ring is done with.
+//--------------------------------------------------------------------
+void
+agave::details::BIoReactor::loop_completions(void)
+{
+#if defined(_BIO_URING__)
+	_th = std::thread([this](void)
+		{
+			BWorkBatch batch;
+			std::vector<BIoRequest*> done;
+			auto is_exit = false;
+
+			while (!is_exit)
+			{
+				auto ret = _ring->wait();
+
+				std::unique_lock lck(_sq_mx);
+
+				auto head = *_ring->_cq_head;
+				auto tail = std::atomic_ref<unsigned>(*_ring->_cq_tail).load(std::memory_order::acquire);
+
+				for (; head != tail; ++head)
+				{
+					auto& cqe = _ring->_cqes[head & _ring->_cq_mask];
+					if (cqe.user_data == __tag_ignored)
+						continue;
+
+					auto req = reinterpret_cast<BIoRequest*>(cqe.user_data & __tag_address_mask);
+					unlink(req);
+					req->_result = cqe.res;
+					done.push_back(req);
+				}
+
+				std::atomic_ref<unsigned>(*_ring->_cq_head).store(head, std::memory_order::release);
+
+				if (ret)
+					_error = ret;
+
+				if (ret || (_is_exit && _error))
+				{
+					while (auto req = _in_flight)
+					{
+						unlink(req);
+						req->_result = _error;
+						done.push_back(req);
+					}
+				}
+
+				is_exit = ret || (_is_exit && !_in_flight);
+
+				lck.unlock();
+
+				for (auto req : done)
+					req->_complete(req, batch);
+
+				done.clear();
+
+				if (!batch.empty())
+				{
+					BJobScheduler::dispatch(batch);
+					batch.clear();
+				}
+			}
+
+		});
+#endif
+}
+
+
+//--------------------------------------------------------------------
@@ -0,0 +1,166 @@
+//--------------------------------------------------------------------
+//	BIoReactor.h.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	I/O Reactor - A Part of Agave(TM) Coroutine Framework 
+//		(based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#pragma once
+
+#ifndef _BIO_REACTOR_H__
+#define _BIO_REACTOR_H__
+
+
+//--------------------------------------------------------------------
+//	headers.
+//--------------------------------------------------------------------
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+#include "B_Object.hpp"
+
+
+//--------------------------------------------------------------------
+namespace agave::details
+{
+	//--------------------------------------------------------------------
+	// incomplete types.
+	//--------------------------------------------------------------------
+	class BWorkBatch;
+
+
+	//--------------------------------------------------------------------
+	//	operations of BIoReactor.
+	//--------------------------------------------------------------------
+	enum class BIoOp
+	{
+		read,
+		write,
+		read_fixed,			// into a registered buffer, '_buf_index'.
+		write_fixed,		// from a registered buffer, ditto.
+		fsync,
+		fdatasync,
+	};
+
+
+	//--------------------------------------------------------------------
+	//	intrusive request, owned by the caller (e.g. embedded in an
+	//	awaiter) until '_complete' runs on the completion thread, which
+	//	adds the work of the wakeup to the batch of the completions.
+	//	* '_result' is the bytes transferred, or -errno.
+	//	* '_offset' of -1 reads / writes at the file position.
+	//	* the reactor links the requests in flight by '_prev' / '_next'.
+	//--------------------------------------------------------------------
+	class BIoRequest
+	{
+	public:
+		BIoOp									_op{ BIoOp::read };
+		int										_fd{ -1 };
+		void*									_buf{ nullptr };
+		unsigned								_len{ 0u };
+		std::uint64_t							_offset{ 0u };
+		unsigned								_buf_index{ 0u };
+		int										_result{ 0 };
+		void									(*_complete)(BIoRequest* req, BWorkBatch& batch) { nullptr };
+		std::uint64_t							_tag{ 0u };		// tags the request in flight, set by submit.
+		BIoRequest*								_prev{ nullptr };	// guarded by the reactor.
+		BIoRequest*								_next{ nullptr };	// ditto.
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	I/O reactor over a Linux io_uring, by the raw system calls.
+	//	* the submitters fill the submission queue under a lock, the one
+	//	  that finds nobody submitting enters the kernel for all of the
+	//	  entries queued meanwhile, so the concurrent submissions go by
+	//	  batches.
+	//	* between begin_batch() and end_batch(), the thread leaves its
+	//	  entries queued, end_batch() submits all of them by one call.
+	//	  the depth is of the thread, a batch is never suspended across.
+	//	* one completion thread waits in the kernel, and dispatches all of
+	//	  the completions reaped by one wakeup as one batch.
+	//	* the registered buffers are pinned once by the kernel, the fixed
+	//	  reads and writes skip mapping them for each request.
+	//	* a hard error of the ring fails the requests queued and in flight
+	//	  with it, then the later submissions.
+	//	* the requests still in flight when the reactor goes away are
+	//	  canceled, they complete before it is gone.
+	//	* elsewhere, or if the kernel refuses io_uring, it is unavailable
+	//	  and the submissions fail with -ENOSYS.
+	//--------------------------------------------------------------------
+	class BIoReactor : public espresso::utilities::B_Object<BIoReactor>
+	{
+		DefineMakeObjFriend;
+
+	public:
+		static auto instance_ptr(void) -> std::shared_ptr<BIoReactor>;
+		static auto instance(void) -> BIoReactor*;
+		static void destroy_instance(void);
+		static bool select_entries(unsigned count);
+
+		bool is_available(void) const noexcept;
+		int submit(BIoRequest* req);
+		void cancel(std::uint64_t tag);
+		unsigned begin_batch(void) noexcept;
+		void end_batch(unsigned depth);
+		bool register_buffers(std::span<std::span<std::byte> const> buffers);
+		bool unregister_buffers(void);
+		std::size_t submissions(void) const noexcept;
+
+	private:
+		class ring_t;
+
+		explicit BIoReactor(unsigned entries);
+
+		BIoReactor(BIoReactor const& other) = delete;
+		BIoReactor(BIoReactor&& other) = delete;
+		static void delete_self(BIoReactor* p);
+
+		~BIoReactor(void);
+
+		template <typename Fill>
+		int queue(Fill const& fill);
+		void flush(std::unique_lock<std::mutex>& lck);
+		void link(BIoRequest* req) noexcept;
+		void unlink(BIoRequest* req) noexcept;
+		void loop_completions(void);
+
+	private:
+		static std::shared_ptr<BIoReactor>				_b_io_reactor;
+		static std::atomic<BIoReactor*>					_instance;		// published under '_instance_mx'.
+		static std::mutex								_instance_mx;
+		static bool										_is_closed;		// ditto, while no instance is made.
+		static unsigned									_entries;
+
+		std::unique_ptr<ring_t>							_ring;
+		std::mutex										_sq_mx;
+		unsigned										_unsubmitted{ 0u };		// guarded by '_sq_mx'.
+		bool											_is_submitting{ false };	// ditto.
+		bool											_is_exit{ false };		// ditto.
+		int												_error{ 0 };			// ditto, the hard error of the ring.
+		BIoRequest*										_in_flight{ nullptr };	// ditto.
+		std::atomic<std::uint64_t>						_next_tag{ 0u };
+		std::atomic<std::size_t>						_submissions{ 0u };		// the system calls.
+		std::thread										_th;
+
+
+	};
+
+
+	//--------------------------------------------------------------------
+
+
+}
+
+
+//--------------------------------------------------------------------
+#endif // !_BIO_REACTOR_H__
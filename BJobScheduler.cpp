@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------
 //	BJobScheduler.cpp.
 //	09/27/2022.				created.
-//	08/05/2024.				last modified.
+//	10/17/2026.				last modified.
 //--------------------------------------------------------------------
 //	*	Job Scheduler - A Part of Agave(TM) Coroutine Framework 
 //		(based on ISO C++20 or later).
@@ -10,8 +10,19 @@
 //	*	by bubo.
 //--------------------------------------------------------------------
 #include "BJobScheduler.h"
+#include "BThreadPool.h"
 #include <algorithm>
-#include <execution>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/timerfd.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
 
 
 //--------------------------------------------------------------------
@@ -22,8 +33,13 @@ using namespace std::chrono_literals;
 // initialize static variables.
 //--------------------------------------------------------------------
 constinit std::shared_ptr<agave::details::BJobScheduler> agave::details::BJobScheduler::_b_job_scheduler{ nullptr };
+constinit std::atomic<agave::details::BJobScheduler*> agave::details::BJobScheduler::_instance{ nullptr };
 std::mutex agave::details::BJobScheduler::_instance_mx;
-constinit unsigned long long agave::details::BJobScheduler::_next_tok_id{ 1ull };
+constinit bool agave::details::BJobScheduler::_is_closed{ false };
+constinit agave::BJobBackend agave::details::BJobScheduler::_backend{ agave::BJobBackend::list };
+constinit unsigned agave::details::BJobScheduler::_shard_count{ 0u };
+constinit agave::BJobTimer agave::details::BJobScheduler::_timer{ agave::BJobTimer::condition_variable };
+constinit agave::details::BDuration agave::details::BJobScheduler::_tolerance{ 1ms };
 
 
 //--------------------------------------------------------------------
@@ -36,6 +52,385 @@ namespace agave::details
 	std::function<void(std::function<void(void)>)>		__BGThread;
 	std::function<void(std::function<void(void)>)>		__FGThread;
 
+
+	//--------------------------------------------------------------------
+	//	backend: pending jobs sorted by time point in a linked list.
+	//	O(n) insertion, O(1) erasing and expiry.
+	//--------------------------------------------------------------------
+	class BJobListQueue : public BJobQueue
+	{
+	public:
+		//--------------------------------------------------------------------
+		void push(BJobNode* node) override
+		{
+			BJobNode* prev = nullptr;
+			auto cur = _head;
+
+			// keep FIFO order for the jobs with the same time point.
+			while (cur && !(node->_tp < cur->_tp))
+			{
+				prev = cur;
+				cur = cur->_next;
+			}
+
+			node->_prev = prev;
+			node->_next = cur;
+
+			if (prev)
+				prev->_next = node;
+			else
+				_head = node;
+
+			if (cur)
+				cur->_prev = node;
+
+		}
+
+		//--------------------------------------------------------------------
+		void erase(BJobNode* node) override
+		{
+			unlink(node);
+		}
+
+		//--------------------------------------------------------------------
+		BJobNode* pop_expired(BTimePoint now) override
+		{
+			if (!_head || now < _head->_tp)
+				return nullptr;
+
+			auto node = _head;
+			unlink(node);
+
+			return node;
+
+		}
+
+		//--------------------------------------------------------------------
+		BJobNode* take_all(void) override
+		{
+			auto node = _head;
+			_head = nullptr;
+
+			return node;
+		}
+
+		//--------------------------------------------------------------------
+		BTimePoint next_deadline(void) const override
+		{
+			return _head ? _head->_tp : BTimePoint::max();
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		void unlink(BJobNode* node) noexcept
+		{
+			if (node->_prev)
+				node->_prev->_next = node->_next;
+			else
+				_head = node->_next;
+
+			if (node->_next)
+				node->_next->_prev = node->_prev;
+
+			node->_prev = node->_next = nullptr;
+
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		BJobNode*										_head{ nullptr };
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	backend: hierarchical timing wheel.
+	//	* 6 levels of 64 slots, each level is 64 times coarser than the
+	//	  previous one, covers 2^36 ticks (~795 days for 1ms ticks).
+	//	* a job is linked into the slot of the level which its distance
+	//	  falls into, and cascaded into the lower levels when the wheel
+	//	  reaches the slot - O(1) insertion, erasing and expiry.
+	//	* a bitmap per level finds the next non-empty slot, so the wheel
+	//	  jumps over idle ticks instead of walking them one by one.
+	//--------------------------------------------------------------------
+	class BJobWheelQueue : public BJobQueue
+	{
+	public:
+		//--------------------------------------------------------------------
+		static constexpr unsigned						_slot_bits{ 6u };
+		static constexpr unsigned						_slot_count{ 1u << _slot_bits };
+		static constexpr unsigned						_slot_mask{ _slot_count - 1u };
+		static constexpr unsigned						_level_count{ 6u };
+		static constexpr unsigned						_expired_slot{ _slot_count * _level_count };
+		static constexpr unsigned long long				_max_distance{ (1ull << (_slot_bits * _level_count)) - 1ull };
+
+		//--------------------------------------------------------------------
+		BJobWheelQueue(BDuration resolution) :
+			_origin{ BClock::now() },
+			_resolution{ resolution }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		void push(BJobNode* node) override
+		{
+			if (!_count++)		// re-synchronize the idle wheel with the clock.
+				_cur = std::max(_cur, floor_tick(BClock::now()));
+
+			insert(node);
+		}
+
+		//--------------------------------------------------------------------
+		void erase(BJobNode* node) override
+		{
+			unlink(node);
+			--_count;
+		}
+
+		//--------------------------------------------------------------------
+		BJobNode* pop_expired(BTimePoint now) override
+		{
+			if (!_slots[_expired_slot])
+				advance(floor_tick(now));
+
+			auto node = _slots[_expired_slot];
+			if (node)
+			{
+				unlink(node);
+				--_count;
+			}
+
+			return node;
+
+		}
+
+		//--------------------------------------------------------------------
+		BJobNode* take_all(void) override
+		{
+			BJobNode* chain = nullptr;
+
+			for (auto slot = 0u; slot <= _expired_slot; ++slot)
+			{
+				while (auto node = _slots[slot])
+				{
+					unlink(node);
+					node->_next = chain;
+					chain = node;
+				}
+			}
+
+			_count = 0u;
+
+			return chain;
+
+		}
+
+		//--------------------------------------------------------------------
+		BTimePoint next_deadline(void) const override
+		{
+			if (_slots[_expired_slot])
+				return _slots[_expired_slot]->_tp;
+
+			auto tick = next_tick();
+			if (tick == ~0ull)
+				return BTimePoint::max();
+
+			return _origin + _resolution * static_cast<long long>(tick);
+
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		void insert(BJobNode* node) noexcept
+		{
+			// due already, not held back until the next tick.
+			if (ceil_tick(node->_tp) < _cur)
+				return append_expired(node);
+
+			auto tick = std::max(ceil_tick(node->_tp), _cur);
+			auto distance = std::min(tick - _cur, _max_distance);
+			tick = _cur + distance;
+
+			auto level = 0u;
+			while (level + 1u < _level_count && distance >> (_slot_bits * (level + 1u)))
+				++level;
+
+			link(node, level * _slot_count +
+				static_cast<unsigned>((tick >> (_slot_bits * level)) & _slot_mask));
+
+		}
+
+		//--------------------------------------------------------------------
+		unsigned long long ceil_tick(BTimePoint tp) const noexcept
+		{
+			if (tp <= _origin)
+				return 0ull;
+
+			return static_cast<unsigned long long>((tp - _origin + _resolution - BDuration{ 1 }) / _resolution);
+		}
+
+		//--------------------------------------------------------------------
+		unsigned long long floor_tick(BTimePoint tp) const noexcept
+		{
+			if (tp <= _origin)
+				return 0ull;
+
+			return static_cast<unsigned long long>((tp - _origin) / _resolution);
+		}
+
+		//--------------------------------------------------------------------
+		//	the nearest tick at which a slot expires or has to be cascaded.
+		//--------------------------------------------------------------------
+		unsigned long long next_tick(void) const noexcept
+		{
+			auto next = ~0ull;
+
+			for (auto level = 0u; level < _level_count; ++level)
+			{
+				if (!_bits[level])
+					continue;
+
+				// the current slot is due right now if the wheel stays at its
+				// boundary, otherwise it belongs to the next round.
+				auto shift = _slot_bits * level;
+				auto round = (_cur & ((1ull << shift) - 1ull)) ? 1ull : 0ull;
+				auto pos = static_cast<int>(((_cur >> shift) + round) & _slot_mask);
+				auto k = std::countr_zero(std::rotr(_bits[level], pos));
+
+				next = std::min(next, ((_cur >> shift) + round + k) << shift);
+
+			}
+
+			return next;
+
+		}
+
+		//--------------------------------------------------------------------
+		void advance(unsigned long long now_tick)
+		{
+			for (auto tick = next_tick(); tick <= now_tick; tick = next_tick())
+			{
+				_cur = tick;
+
+				// cascade the higher levels whose boundary has been reached.
+				for (auto level = 1u; level < _level_count; ++level)
+				{
+					auto shift = _slot_bits * level;
+					if (_cur & ((1ull << shift) - 1ull))
+						break;
+
+					cascade(level * _slot_count + static_cast<unsigned>((_cur >> shift) & _slot_mask));
+				}
+
+				// move the due slot to the expired list.
+				auto slot = static_cast<unsigned>(_cur & _slot_mask);
+				while (auto node = _slots[slot])
+				{
+					unlink(node);
+					append_expired(node);
+				}
+
+				_cur = tick + 1ull;
+
+			}
+
+			_cur = std::max(_cur, now_tick + 1ull);
+
+		}
+
+		//--------------------------------------------------------------------
+		void cascade(unsigned slot)
+		{
+			auto node = _slots[slot];
+			_slots[slot] = nullptr;
+			_bits[slot / _slot_count] &= ~(1ull << (slot & _slot_mask));
+
+			while (node)
+			{
+				auto next = node->_next;
+				node->_prev = node->_next = nullptr;
+
+				insert(node);
+
+				node = next;
+			}
+
+		}
+
+		//--------------------------------------------------------------------
+		void link(BJobNode* node, unsigned slot) noexcept
+		{
+			node->_slot = slot;
+			node->_prev = nullptr;
+			node->_next = _slots[slot];
+
+			if (_slots[slot])
+				_slots[slot]->_prev = node;
+
+			_slots[slot] = node;
+
+			if (slot < _expired_slot)
+				_bits[slot / _slot_count] |= 1ull << (slot & _slot_mask);
+
+		}
+
+		//--------------------------------------------------------------------
+		void append_expired(BJobNode* node) noexcept
+		{
+			node->_slot = _expired_slot;
+			node->_next = nullptr;
+			node->_prev = _expired_tail;
+
+			if (_expired_tail)
+				_expired_tail->_next = node;
+			else
+				_slots[_expired_slot] = node;
+
+			_expired_tail = node;
+
+		}
+
+		//--------------------------------------------------------------------
+		void unlink(BJobNode* node) noexcept
+		{
+			auto slot = node->_slot;
+
+			if (node->_prev)
+				node->_prev->_next = node->_next;
+			else
+				_slots[slot] = node->_next;
+
+			if (node->_next)
+				node->_next->_prev = node->_prev;
+			else if (slot == _expired_slot)
+				_expired_tail = node->_prev;
+
+			if (!_slots[slot] && slot < _expired_slot)
+				_bits[slot / _slot_count] &= ~(1ull << (slot & _slot_mask));
+
+			node->_prev = node->_next = nullptr;
+
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		BTimePoint										_origin;
+		BDuration										_resolution;
+		unsigned long long								_cur{ 0ull };		// the next tick to be processed.
+		std::size_t										_count{ 0u };
+		unsigned long long								_bits[_level_count]{};
+		BJobNode*										_slots[_expired_slot + 1u]{};
+		BJobNode*										_expired_tail{ nullptr };
+
+	};
+
 	//--------------------------------------------------------------------
 
 
@@ -114,17 +509,154 @@ agave::BJobToken::BJobToken(unsigned long long tok_id) : _tok_id{ tok_id }
 }
 
 
+//--------------------------------------------------------------------
+//	one shard of the pending jobs, with its own lock and expiry thread.
+//--------------------------------------------------------------------
+class agave::details::BJobScheduler::shard_t
+{
+public:
+	unsigned										_index{ 0u };
+	std::mutex										_mx;
+	std::condition_variable							_cv;
+	std::unique_ptr<BJobQueue>						_pending_jobs;
+	std::vector<std::unique_ptr<BJobNode[]>>		_node_chunks;		// slot table.
+	BJobNode*										_free_nodes{ nullptr };
+	std::shared_ptr<BThreadPool>					_pool;			// default job executor, set once built.
+	std::thread										_th;
+	std::atomic<std::size_t>						_wakeups{ 0u };
+	std::vector<BJobNode*>							_expired;		// reused by the expiry thread.
+	BWorkBatch										_batch;			// ditto.
+	int												_timer_fd{ -1 };	// BJobTimer::timerfd only.
+	int												_epoll_fd{ -1 };	// ditto.
+
+	//--------------------------------------------------------------------
+	~shard_t(void)
+	{
+		close_timer();
+	}
+
+	//--------------------------------------------------------------------
+	//	falls back to the condition variable if the fds are not available.
+	//--------------------------------------------------------------------
+	void open_timer(void)
+	{
+#if defined(__linux__)
+		_timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		_epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+
+		epoll_event ev{};
+		ev.events = EPOLLIN;
+		ev.data.fd = _timer_fd;
+
+		if (_timer_fd < 0 || _epoll_fd < 0 ||
+			::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _timer_fd, &ev) < 0)
+			close_timer();
+#endif
+	}
+
+	//--------------------------------------------------------------------
+	void close_timer(void)
+	{
+#if defined(__linux__)
+		if (_timer_fd >= 0)
+			::close(_timer_fd);
+
+		if (_epoll_fd >= 0)
+			::close(_epoll_fd);
+#endif
+		_timer_fd = _epoll_fd = -1;
+	}
+
+	//--------------------------------------------------------------------
+	//	expires at 'tp' of the steady clock (CLOCK_MONOTONIC), never for
+	//	BTimePoint::max(), at once for the past time points.
+	//--------------------------------------------------------------------
+	void arm_timer(BTimePoint tp)
+	{
+#if defined(__linux__)
+		itimerspec spec{};
+		if (tp != BTimePoint::max())
+		{
+			auto ns = std::max<long long>(tp.time_since_epoch() / 1ns, 1ll);
+			spec.it_value.tv_sec = static_cast<time_t>(ns / 1'000'000'000ll);
+			spec.it_value.tv_nsec = static_cast<long>(ns % 1'000'000'000ll);
+		}
+
+		::timerfd_settime(_timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+#endif
+	}
+
+	//--------------------------------------------------------------------
+	void wait_timer(void)
+	{
+#if defined(__linux__)
+		epoll_event ev{};
+		while (::epoll_wait(_epoll_fd, &ev, 1, -1) < 0 && errno == EINTR)
+			;
+
+		unsigned long long ticks = 0ull;	// resets the readiness.
+		(void)::read(_timer_fd, &ticks, sizeof(ticks));
+#endif
+	}
+
+};
+
+
+//--------------------------------------------------------------------
+namespace agave::details
+{
+	//--------------------------------------------------------------------
+	//	the shard of the current thread, assigned round robin on first use.
+	//--------------------------------------------------------------------
+	static std::atomic<unsigned>						__next_shard{ 0u };
+	static thread_local unsigned						__tls_shard{ ~0u };
+
+	//--------------------------------------------------------------------
+	//	the custom job entry if any, else the pool, 'nullptr' for the
+	//	instance of the pool, or this thread once that is gone at exit.
+	//--------------------------------------------------------------------
+	static void submit_batch(BWorkBatch& batch, BThreadPool* pool)
+	{
+		if (batch.empty())
+			return;
+
+		if (__JobThread)
+		{
+			for (auto item : batch._items)
+				__JobThread([item] { BWorkBatch::run(item); });
+		}
+		else if (auto target = pool ? pool : BThreadPool::instance())
+			target->submit(batch);
+		else
+		{
+			for (auto item : batch._items)
+				BWorkBatch::run(item);
+		}
+
+		batch.clear();
+
+	}
+
+	//--------------------------------------------------------------------
+
+
+}
+
+
+//--------------------------------------------------------------------
+//	made on first use, and made again after destroy_instance(), but
+//	not while the instance is destroyed, nor once the statics are.
 //--------------------------------------------------------------------
 auto
 agave::details::BJobScheduler::instance_ptr(void) ->
 std::shared_ptr<agave::details::BJobScheduler>
 {
-	if (!_b_job_scheduler)
+	std::unique_lock lck{ _instance_mx };
+	if (!_b_job_scheduler && !_is_closed)
 	{
-		std::unique_lock lck{ _instance_mx };
-		if (!_b_job_scheduler)
-			_b_job_scheduler = espresso::utilities::make_obj<BJobScheduler>(
-				&BJobScheduler::delete_self);
+		_b_job_scheduler = espresso::utilities::make_obj<BJobScheduler>(
+			&BJobScheduler::delete_self, _backend, _shard_count, _timer, _tolerance);
+		_instance.store(_b_job_scheduler.get(), std::memory_order::release);
 	}
 
 	return _b_job_scheduler;
@@ -132,13 +664,103 @@ std::shared_ptr<agave::details::BJobScheduler>
 }
 
 
+//--------------------------------------------------------------------
+//	the raw pointer, without touching the reference count, 'nullptr'
+//	when instance_ptr() makes none.
+//--------------------------------------------------------------------
+auto
+agave::details::BJobScheduler::instance(void) ->
+agave::details::BJobScheduler*
+{
+	if (auto p = _instance.load(std::memory_order::acquire))
+		return p;
+
+	return instance_ptr().get();
+
+}
+
+
 //--------------------------------------------------------------------
 void
 agave::details::BJobScheduler::destroy_instance(void)
 {
 	std::unique_lock lck(_instance_mx);
-	if (_b_job_scheduler)
-		_b_job_scheduler = nullptr;
+	auto p = std::exchange(_b_job_scheduler, nullptr);
+	_instance.store(nullptr, std::memory_order::release);
+	_is_closed = true;
+	lck.unlock();
+
+	// destroyed without the lock, the calls meanwhile get no instance,
+	// rather than a new one.
+	p = nullptr;
+
+	lck.lock();
+	_is_closed = false;
+
+}
+
+
+//--------------------------------------------------------------------
+//	the backend takes effect when the instance is created, returns
+//	false if the current instance still uses the previous one.
+//--------------------------------------------------------------------
+bool
+agave::details::BJobScheduler::select_backend(BJobBackend backend)
+{
+	std::unique_lock lck(_instance_mx);
+	_backend = backend;
+
+	return !_b_job_scheduler;
+
+}
+
+
+//--------------------------------------------------------------------
+//	the number of shards, 0 for one per hardware thread. it takes effect
+//	when the instance is created, same as the backend.
+//--------------------------------------------------------------------
+bool
+agave::details::BJobScheduler::select_shards(unsigned count)
+{
+	std::unique_lock lck(_instance_mx);
+	_shard_count = std::min(count, 1u << _shard_bits);
+
+	return !_b_job_scheduler;
+
+}
+
+
+//--------------------------------------------------------------------
+//	how the expiry threads wait, takes effect the same way as the
+//	backend. the timerfd is available on Linux only.
+//--------------------------------------------------------------------
+bool
+agave::details::BJobScheduler::select_timer(BJobTimer timer)
+{
+#if !defined(__linux__)
+	if (timer == BJobTimer::timerfd)
+		return false;
+#endif
+
+	std::unique_lock lck(_instance_mx);
+	_timer = timer;
+
+	return !_b_job_scheduler;
+
+}
+
+
+//--------------------------------------------------------------------
+//	the resolution of the timing wheel, which a job may expire late by.
+//	it takes effect the same way as the backend.
+//--------------------------------------------------------------------
+bool
+agave::details::BJobScheduler::select_tolerance(BDuration tolerance)
+{
+	std::unique_lock lck(_instance_mx);
+	_tolerance = std::max<BDuration>(tolerance, 1us);
+
+	return !_b_job_scheduler;
 
 }
 
@@ -147,11 +769,33 @@ agave::details::BJobScheduler::destroy_instance(void)
 agave::BJobToken
 agave::details::BJobScheduler::add_job(
 	BDuration dur,
-	BCallBack cb)
+	BCallBack cb,
+	BDuration slack)
+{
+	return add_job_at(BClock::now() + dur, std::move(cb), slack);
+}
+
+
+//--------------------------------------------------------------------
+//	queues a job expiring at an absolute time point of the steady clock,
+//	periodic jobs advance their own deadline and never drift.
+//--------------------------------------------------------------------
+agave::BJobToken
+agave::details::BJobScheduler::add_job_at(
+	BTimePoint tp,
+	BCallBack cb,
+	BDuration slack)
 {
-	std::unique_lock lck(_mx);
-	auto job_tok = insert_new_job(dur, cb);
-	_cv.notify_all();
+	auto& shard = local_shard();
+	tp = coalesce(tp, slack);
+
+	std::unique_lock lck(shard._mx);
+	auto deadline = shard._pending_jobs->next_deadline();
+	auto job_tok = insert_new_job(shard, tp, cb);
+
+	// wake up the loop only if the new job expires earlier.
+	if (auto next = shard._pending_jobs->next_deadline(); next < deadline)
+		wake_up(shard, next);
 
 	return job_tok;
 
@@ -162,21 +806,50 @@ agave::details::BJobScheduler::add_job(
 bool
 agave::details::BJobScheduler::remove_job(BJobToken const& tok)
 {
-	std::unique_lock lck(_mx);
+	auto shard = shard_of(tok);
+	if (!shard)
+		return false;
 
-	if (remove_job_by_token(tok))
-	{
-		_cv.notify_all();
-		return true;
-	}
-	else if (std::get<BJobToken>(_cur_item) == tok)
+	std::unique_lock lck(shard->_mx);
+	return remove_job_by_token(*shard, tok);
+
+}
+
+
+//--------------------------------------------------------------------
+//	removes the jobs under one lock per run of tokens of the same shard,
+//	the removed tokens are cleared.
+//--------------------------------------------------------------------
+std::size_t
+agave::details::BJobScheduler::remove_jobs(std::span<BJobToken> toks)
+{
+	std::size_t count = 0u;
+	std::unique_lock<std::mutex> lck;
+	shard_t* locked = nullptr;
+
+	for (auto& tok : toks)
 	{
-		_cur_item = { nullptr, std::chrono::high_resolution_clock::now(), nullptr };
-		_cv.notify_all();
-		return true;
+		auto shard = shard_of(tok);
+		if (!shard)
+			continue;
+
+		if (shard != locked)	// never holds two shards at once.
+		{
+			if (lck)
+				lck.unlock();
+
+			lck = std::unique_lock(shard->_mx);
+			locked = shard;
+		}
+
+		if (remove_job_by_token(*shard, tok))
+		{
+			tok = nullptr;
+			++count;
+		}
 	}
 
-	return false;
+	return count;
 
 }
 
@@ -185,23 +858,192 @@ agave::details::BJobScheduler::remove_job(BJobToken const& tok)
 bool
 agave::details::BJobScheduler::clear_all_jobs(void)
 {
-	std::unique_lock lck(_mx);
-	if (size_t size = _pending_jobs.size(); size > 0u)
+	auto is_cleared = false;
+
+	for (auto& shard : _shards)
+	{
+		std::vector<BJobNode*> dropped;
+		std::unique_lock lck(shard->_mx);
+		auto node = shard->_pending_jobs->take_all();
+		if (!node)
+			continue;
+
+		while (node)
+		{
+			auto next = node->_next;
+			discard_node(*shard, node, dropped);
+			node = next;
+		}
+
+		wake_up(*shard, BTimePoint::min());
+		is_cleared = true;
+		lck.unlock();
+
+		BWorkBatch batch;
+		for (auto dropped_node : dropped)
+			dropped_node->_drop(dropped_node, batch);
+
+		if (!batch.empty())
+			dispatch(*shard, batch);
+	}
+
+	return is_cleared;
+
+}
+
+
+//--------------------------------------------------------------------
+//	queues an intrusive job, no allocation. the node must stay alive
+//	until it fires or is removed.
+//	* a linked node always goes to the shard of its link, thus the
+//	  cancellation finds it without touching the node.
+//--------------------------------------------------------------------
+void
+agave::details::BJobScheduler::add_job(
+	BDuration dur,
+	BJobNode* node,
+	BDuration slack)
+{
+	add_job_at(BClock::now() + dur, node, slack);
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BJobScheduler::add_job_at(
+	BTimePoint tp,
+	BJobNode* node,
+	BDuration slack)
+{
+	auto& shard = node->_link ? shard_of(node->_link) : local_shard();
+	node->_tp = coalesce(tp, slack);
+
+	std::unique_lock lck(shard._mx);
+	auto deadline = shard._pending_jobs->next_deadline();
+
+	shard._pending_jobs->push(node);
+	if (node->_link)
+		*node->_link = node;
+
+	// wake up the loop only if the new job expires earlier.
+	if (auto next = shard._pending_jobs->next_deadline(); next < deadline)
+		wake_up(shard, next);
+
+}
+
+
+//--------------------------------------------------------------------
+//	the latest time point within [tp, tp + slack] on the grid of the
+//	largest power of two nanoseconds not above the slack. the grids
+//	nest, thus the close deadlines collapse into the same time point
+//	and expire together, never early and at most 'slack' late.
+//--------------------------------------------------------------------
+agave::details::BTimePoint
+agave::details::BJobScheduler::coalesce(
+	BTimePoint tp,
+	BDuration slack) noexcept
+{
+	if (slack <= BDuration::zero() || tp.time_since_epoch() < BDuration::zero() ||
+		tp > BTimePoint::max() - slack)
+		return tp;
+
+	auto grain = std::bit_floor(static_cast<unsigned long long>(slack.count()));
+	auto latest = static_cast<unsigned long long>((tp + slack).time_since_epoch().count());
+
+	return BTimePoint{ BDuration{ static_cast<BDuration::rep>(latest - latest % grain) } };
+
+}
+
+
+//--------------------------------------------------------------------
+//	the number of times the expiry threads woke up, for diagnostics.
+//--------------------------------------------------------------------
+std::size_t
+agave::details::BJobScheduler::wakeups(void) const noexcept
+{
+	std::size_t count = 0u;
+	for (auto& shard : _shards)
+		count += shard->_wakeups.load(std::memory_order::relaxed);
+
+	return count;
+
+}
+
+
+//--------------------------------------------------------------------
+//	removes the intrusive jobs referred by the links under one lock per
+//	run of links of the same shard, 'removed[i]' is the node removed
+//	through 'links[i]', or null.
+//--------------------------------------------------------------------
+std::size_t
+agave::details::BJobScheduler::remove_jobs(
+	std::span<BJobNode** const> links,
+	std::span<BJobNode*> removed)
+{
+	std::size_t count = 0u;
+	std::unique_lock<std::mutex> lck;
+	shard_t* locked = nullptr;
+
+	for (std::size_t i = 0u; i < links.size(); ++i)
 	{
-		_pending_jobs.clear();
-		_cv.notify_all();
-		return true;
+		auto& shard = shard_of(links[i]);
+		if (&shard != locked)	// never holds two shards at once.
+		{
+			if (lck)
+				lck.unlock();
+
+			lck = std::unique_lock(shard._mx);
+			locked = &shard;
+		}
+
+		auto node = *links[i];
+		removed[i] = node;
+		if (!node)
+			continue;
+
+		shard._pending_jobs->erase(node);
+		*links[i] = nullptr;
+		node->_link = nullptr;
+		++count;
 	}
 
-	return false;
+	return count;
 
 }
 
 
 //--------------------------------------------------------------------
-agave::details::BJobScheduler::BJobScheduler(void)
+agave::details::BJobScheduler::BJobScheduler(
+	BJobBackend backend,
+	unsigned shard_count,
+	BJobTimer timer,
+	BDuration tolerance)
 {
-	loop_jobs();
+	if (!shard_count)
+		shard_count = std::clamp(std::thread::hardware_concurrency(), 1u, 1u << _shard_bits);
+
+	// the shards hold the pool, which outlives the scheduler then. it is
+	// never set later, since any thread may dispatch for a shard.
+	auto pool = __JobThread ? nullptr : BThreadPool::instance_ptr();
+
+	for (auto i = 0u; i < shard_count; ++i)
+	{
+		auto& shard = _shards.emplace_back(std::make_unique<shard_t>());
+		shard->_index = i;
+		shard->_pool = pool;
+
+		if (backend == BJobBackend::list)
+			shard->_pending_jobs = std::make_unique<BJobListQueue>();
+		else
+			shard->_pending_jobs = std::make_unique<BJobWheelQueue>(tolerance);
+
+		if (timer == BJobTimer::timerfd)
+			shard->open_timer();
+	}
+
+	for (auto& shard : _shards)
+		loop_jobs(*shard);
+
 }
 
 
@@ -209,162 +1051,383 @@ agave::details::BJobScheduler::BJobScheduler(void)
 void
 agave::details::BJobScheduler::delete_self(BJobScheduler* p)
 {
-	if (p)
-		delete p;
+	if (!p)
+		return;
+
+	// still published, the static itself went away at exit.
+	std::unique_lock lck(_instance_mx);
+	if (_instance.load(std::memory_order::relaxed) == p)
+	{
+		_instance.store(nullptr, std::memory_order::release);
+		_is_closed = true;
+	}
+
+	lck.unlock();
+
+	delete p;
+
 }
 
 
 //--------------------------------------------------------------------
 agave::details::BJobScheduler::~BJobScheduler(void)
 {
-	_is_exit = true;
-	_cv.notify_all();
+	for (auto& shard : _shards)
+	{
+		std::unique_lock lck(shard->_mx);
+		_is_exit = true;
+		wake_up(*shard, BTimePoint::min());
+	}
+
+	for (auto& shard : _shards)
+	{
+		if (shard->_th.joinable())
+			shard->_th.join();
+	}
+
+}
+
+
+//--------------------------------------------------------------------
+inline
+auto
+agave::details::BJobScheduler::local_shard(void) -> shard_t&
+{
+	if (__tls_shard == ~0u)
+		__tls_shard = __next_shard.fetch_add(1u, std::memory_order::relaxed);
 
-	if (_th.joinable())
-		_th.join();
+	return *_shards[__tls_shard % _shards.size()];
 
 }
 
 
+//--------------------------------------------------------------------
+inline
+auto
+agave::details::BJobScheduler::shard_of(BJobToken const& tok) const -> shard_t*
+{
+	auto index = (tok._tok_id >> _index_bits) & ((1ull << _shard_bits) - 1ull);
+	if (!tok || index >= _shards.size())
+		return nullptr;
+
+	return _shards[index].get();
+
+}
+
+
+//--------------------------------------------------------------------
+inline
+auto
+agave::details::BJobScheduler::shard_of(BJobNode** link) const -> shard_t&
+{
+	auto bits = reinterpret_cast<std::uintptr_t>(link) >> 4;
+	auto hash = (bits * 0x9e3779b97f4a7c15ull) >> 32;
+
+	return *_shards[hash % _shards.size()];
+
+}
+
+
+//--------------------------------------------------------------------
+//	a token is (generation << 32 | shard << 24 | index + 1), the full
+//	generation of the slot, which never wraps.
 //--------------------------------------------------------------------
 inline
 auto
 agave::details::BJobScheduler::insert_new_job(
-	BDuration& dur,
+	shard_t& shard,
+	BTimePoint tp,
 	BCallBack& fn) -> agave::BJobToken
 {
-	auto cur_tp = std::chrono::high_resolution_clock::now() + dur;
-	auto it = std::find_if(
-		//std::execution::par,
-		_pending_jobs.begin(),
-		_pending_jobs.end(),
-		[&cur_tp](std::tuple<BJobToken, BTimePoint, BCallBack>& tup) -> bool
-		{
-			return cur_tp > std::get<BTimePoint>(tup);
-		});
+	auto node = acquire_node(shard);
+	node->_tok = agave::BJobToken{
+		(static_cast<unsigned long long>(node->_gen) << 32) |
+		(static_cast<unsigned long long>(shard._index) << _index_bits) |
+		(node->_index + 1ull) };
+	node->_tp = tp;
+	node->_cb = std::move(fn);
 
-	auto tok = agave::BJobToken{ _next_tok_id++ };
+	shard._pending_jobs->push(node);
 
-	if (it == _pending_jobs.end())
-		_pending_jobs.emplace_back(tok, cur_tp, fn);
-	else
-		_pending_jobs.emplace(it, tok, cur_tp, fn);
+	return node->_tok;
+
+}
+
+
+//--------------------------------------------------------------------
+inline
+bool
+agave::details::BJobScheduler::remove_job_by_token(
+	shard_t& shard,
+	BJobToken const& tok)
+{
+	auto node = find_node(shard, tok);
+	if (!node)
+		return false;
 
-	return tok;
+	shard._pending_jobs->erase(node);
+	release_node(shard, node);
+
+	return true;
 
 }
 
 
+//--------------------------------------------------------------------
+//	drops a node which left the queue without firing, the intrusive
+//	ones are only unlinked, their owners keep them, the ones with
+//	'_drop' are collected to be told after unlocking.
 //--------------------------------------------------------------------
 inline
 void
-agave::details::BJobScheduler::insert_new_job(std::tuple<BJobToken, BTimePoint, BCallBack> task_tup)
-{
-	auto cur_tp = std::get<BTimePoint>(task_tup);
-	auto it = std::find_if(
-		//std::execution::par,
-		_pending_jobs.begin(),
-		_pending_jobs.end(),
-		[&cur_tp](std::tuple<BJobToken, BTimePoint, BCallBack>& tup) -> bool
-		{
-			return cur_tp > std::get<BTimePoint>(tup);
-		});
+agave::details::BJobScheduler::discard_node(
+	shard_t& shard,
+	BJobNode* node,
+	std::vector<BJobNode*>& dropped)
+{
+	if (!node->_fire)
+		return release_node(shard, node);
 
-	if (it == _pending_jobs.end())
-		_pending_jobs.emplace_back(task_tup);
-	else
-		_pending_jobs.emplace(it, task_tup);
+	if (node->_link)
+		*node->_link = nullptr;
+
+	node->_link = nullptr;
+
+	if (node->_drop)
+		dropped.push_back(node);
 
 }
 
 
+//--------------------------------------------------------------------
+//	a token refers to a pending job only if the slot still holds the
+//	same token.
 //--------------------------------------------------------------------
 inline
-bool
-agave::details::BJobScheduler::remove_job_by_token(BJobToken const& tok)
+auto
+agave::details::BJobScheduler::find_node(
+	shard_t const& shard,
+	BJobToken const& tok) const -> BJobNode*
 {
-	auto it = std::remove_if(
-		//std::execution::par,
-		_pending_jobs.begin(),
-		_pending_jobs.end(),
-		[&tok](std::tuple<BJobToken, BTimePoint, BCallBack>& tup) -> bool
+	auto index = (tok._tok_id & ((1ull << _index_bits) - 1ull)) - 1ull;
+	if (!tok || (index >> _chunk_bits) >= shard._node_chunks.size())
+		return nullptr;
+
+	auto node = &shard._node_chunks[index >> _chunk_bits][index & ((1ull << _chunk_bits) - 1ull)];
+
+	return node->_tok == tok ? node : nullptr;
+
+}
+
+
+//--------------------------------------------------------------------
+//	nodes are recycled through a free list and allocated in chunks,
+//	the chunks make up the slot table indexed by the tokens, up to
+//	(1 << _index_bits) - 1 slots per shard.
+//--------------------------------------------------------------------
+inline
+auto
+agave::details::BJobScheduler::acquire_node(shard_t& shard) -> BJobNode*
+{
+	if (!shard._free_nodes)
+	{
+		constexpr std::size_t chunk_size = 1u << _chunk_bits;
+		constexpr std::size_t max_chunks = ((1u << _index_bits) - 1u) / chunk_size;
+
+		if (shard._node_chunks.size() >= max_chunks)
+			throw std::length_error("Agave: too many pending jobs.");
+
+		auto base = static_cast<unsigned>(shard._node_chunks.size() * chunk_size);
+		auto& chunk = shard._node_chunks.emplace_back(std::make_unique<BJobNode[]>(chunk_size));
+		for (auto i = chunk_size; i-- > 0u; )
 		{
-			return std::get<BJobToken>(tup) == tok;
-		});
+			chunk[i]._index = base + static_cast<unsigned>(i);
+			chunk[i]._next = shard._free_nodes;
+			shard._free_nodes = &chunk[i];
+		}
 
-	if (it == _pending_jobs.end())
-		return false;
+	}
 
-	while (it != _pending_jobs.end())
-		it = _pending_jobs.erase(it);
+	auto node = shard._free_nodes;
+	shard._free_nodes = node->_next;
+	node->_next = nullptr;
+	++node->_gen;
 
-	return true;
+	return node;
 
 }
 
 
+//--------------------------------------------------------------------
+inline
+void
+agave::details::BJobScheduler::release_node(
+	shard_t& shard,
+	BJobNode* node)
+{
+	node->_tok = nullptr;
+	node->_cb = nullptr;
+	node->_prev = nullptr;
+
+	// the last generation retires the slot, a stale token never matches
+	// a job of a wrapped one.
+	if (node->_gen == ~0u)
+		return;
+
+	node->_next = shard._free_nodes;
+	shard._free_nodes = node;
+
+}
+
+
+//--------------------------------------------------------------------
+//	hands the batch over to the job executor, then clears it.
+//	* the default executor takes it at once, a custom job entry gets
+//	  one call per item.
 //--------------------------------------------------------------------
 void
-agave::details::BJobScheduler::loop_jobs(void)
+agave::details::BJobScheduler::dispatch(BWorkBatch& batch)
 {
-	std::thread th([this](void) -> void
+	submit_batch(batch, nullptr);
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BJobScheduler::dispatch(
+	shard_t& shard,
+	BWorkBatch& batch)
+{
+	submit_batch(batch, shard._pool.get());
+
+}
+
+
+//--------------------------------------------------------------------
+//	makes the expiry thread re-check its queue by 'tp', under the lock
+//	of the shard.
+//--------------------------------------------------------------------
+void
+agave::details::BJobScheduler::wake_up(
+	shard_t& shard,
+	BTimePoint tp)
+{
+	if (shard._timer_fd >= 0)
+		shard.arm_timer(tp);
+	else
+		shard._cv.notify_all();
+
+}
+
+
+//--------------------------------------------------------------------
+//	waits until the deadline or a wake up, the timerfd is armed under
+//	the lock, and waited on without it.
+//--------------------------------------------------------------------
+void
+agave::details::BJobScheduler::wait_for(
+	shard_t& shard,
+	std::unique_lock<std::mutex>& lck,
+	BTimePoint deadline)
+{
+	if (shard._timer_fd >= 0)
+	{
+		shard.arm_timer(deadline);
+		lck.unlock();
+		shard.wait_timer();
+	}
+	else if (deadline == BTimePoint::max())
+		shard._cv.wait(lck);
+	else
+		shard._cv.wait_until(lck, deadline);
+
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BJobScheduler::loop_jobs(shard_t& shard)
+{
+	std::thread th([this, &shard](void) -> void
 		{
+			__tls_shard = shard._index;		// the jobs re-armed from here stay here.
+
 			while (true)
 			{
-				std::unique_lock lck(_mx);
+				std::unique_lock lck(shard._mx);
 
 				if (_is_exit.load())
 				{
-					_pending_jobs.clear();
+					auto& dropped = shard._expired;
+					auto node = shard._pending_jobs->take_all();
+					while (node)
+					{
+						auto next = node->_next;
+						discard_node(shard, node, dropped);
+						node = next;
+					}
+
+					lck.unlock();
+
+					for (auto dropped_node : dropped)
+						dropped_node->_drop(dropped_node, shard._batch);
+
+					dropped.clear();
+					if (!shard._batch.empty())
+						dispatch(shard, shard._batch);
+
 					break;
 				}
-				else if (_pending_jobs.size() == 0)
-				{
-					_cv.wait(lck);
-				}
-				else
-				{
-					_cur_item = _pending_jobs.front();
-					_pending_jobs.pop_front();
 
-					if (std::get<BTimePoint>(_cur_item) - std::chrono::high_resolution_clock::now() > 1ms)
-						_cv.wait_until(lck, std::get<BTimePoint>(_cur_item));
+				// drains all of the expired jobs under one lock.
+				auto now = BClock::now();
+				auto& expired = shard._expired;
+				auto& batch = shard._batch;
 
-					if (std::get<BJobToken>(_cur_item))
+				while (auto node = shard._pending_jobs->pop_expired(now))
+				{
+					// the intrusive job belongs to its owner once unlinked.
+					if (node->_fire)
 					{
-						if (std::get<BTimePoint>(_cur_item) - std::chrono::high_resolution_clock::now() < 1ms)
-						{
-							auto bcb = std::get<BCallBack>(_cur_item);
+						if (node->_link)
+							*node->_link = nullptr;
 
-							if (__JobThread)
-								__JobThread([bcb]() { bcb(); });
-							else
-							{
-								std::thread t(bcb);
-								t.detach();
-							}
+						node->_link = nullptr;
+						expired.push_back(node);
+					}
+					else
+					{
+						batch.add(std::move(node->_cb));
+						release_node(shard, node);
+					}
+				}
 
-						}
-						else // insert into the task pending queue again.
-							insert_new_job(_cur_item);
+				if (expired.empty() && batch.empty())
+				{
+					auto deadline = shard._pending_jobs->next_deadline();
+					if (deadline <= now)
+						continue;
 
-						_cur_item = { nullptr, std::chrono::high_resolution_clock::now(), nullptr };
+					wait_for(shard, lck, deadline);
+					shard._wakeups.fetch_add(1u, std::memory_order::relaxed);
+					continue;
+				}
 
-					}
+				lck.unlock();
+
+				for (auto node : expired)
+					node->_fire(node, batch);
+
+				expired.clear();
+				dispatch(shard, batch);
 
-				}
 			}
 
 		});
 
-	_th = std::move(th);
+	shard._th = std::move(th);
 
 }
 
 
 //--------------------------------------------------------------------
-
-
-
-
-
@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------
 //	BJobScheduler.h.
 //	09/27/2022.				created.
-//	08/05/2024.				last modified.
+//	10/17/2026.				last modified.
 //--------------------------------------------------------------------
 //	*	Job Scheduler - A Part of Agave(TM) Coroutine Framework 
 //		(based on ISO C++20 or later).
@@ -20,9 +20,13 @@
 //--------------------------------------------------------------------
 #include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <thread>
-#include <list>
+#include <vector>
+#include <span>
 #include "B_Object.hpp"
 
 
@@ -35,6 +39,8 @@ namespace agave
 	namespace details
 	{
 		class BJobScheduler;
+		class BThreadPool;
+		class BWorkBatch;
 	}
 
 
@@ -67,6 +73,27 @@ namespace agave
 	};
 
 
+	//--------------------------------------------------------------------
+	//	 Backends (pending job queues) for BJobScheduler
+	//--------------------------------------------------------------------
+	enum class BJobBackend
+	{
+		list,				// sorted list, O(n) insertion, exact, the default.
+		timing_wheel,		// hierarchical timing wheel, O(1) insertion and expiry,
+							// late by up to the tolerance.
+	};
+
+
+	//--------------------------------------------------------------------
+	//	 Timers (how the expiry threads wait) for BJobScheduler
+	//--------------------------------------------------------------------
+	enum class BJobTimer
+	{
+		condition_variable,	// condition_variable::wait_until, portable.
+		timerfd,			// timerfd + epoll_wait, Linux only, sub-millisecond precision.
+	};
+
+
 	//--------------------------------------------------------------------
 
 
@@ -79,11 +106,57 @@ namespace agave::details
 	//--------------------------------------------------------------------
 	//	custom types.
 	//--------------------------------------------------------------------
-	using BTimePoint = std::chrono::high_resolution_clock::time_point;
-	using BDuration = std::chrono::high_resolution_clock::duration;
+	using BClock = std::chrono::steady_clock;	// monotonic, immune to wall clock jumps.
+	using BTimePoint = BClock::time_point;
+	using BDuration = BClock::duration;
 	using BCallBack = std::function<void(void)>;
 
 
+	//--------------------------------------------------------------------
+	//	pending job node, linked into the queue of the backend.
+	//	* the nodes of 'add_job(dur, cb)' are owned by the scheduler.
+	//	* the intrusive nodes are owned by the caller (e.g. embedded in an
+	//	  awaiter), '_fire' runs on the scheduler thread when it expires,
+	//	  and adds the work of the wakeup to the batch of the expiry.
+	//	* '_drop' runs instead if the scheduler discards the node pending,
+	//	  by clear_all_jobs() or on destruction.
+	//	* '*_link' refers to the intrusive node while it is pending.
+	//--------------------------------------------------------------------
+	class BJobNode
+	{
+	public:
+		BJobToken								_tok{ nullptr };	// cleared when the job leaves the queue.
+		unsigned								_index{ 0u };		// index in the slot table.
+		unsigned								_gen{ 0u };			// bumped on every reuse, retired at ~0u.
+		BTimePoint								_tp{};
+		BCallBack								_cb;
+		void									(*_fire)(BJobNode* node, BWorkBatch& batch) { nullptr };	// intrusive only.
+		void									(*_drop)(BJobNode* node, BWorkBatch& batch) { nullptr };	// intrusive only, optional.
+		BJobNode**								_link{ nullptr };	// intrusive only, guarded by the scheduler.
+		BJobNode*								_prev{ nullptr };
+		BJobNode*								_next{ nullptr };
+		unsigned								_slot{ 0u };	// used by timing wheel.
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	pending job queue, implemented by each backend.
+	//--------------------------------------------------------------------
+	class BJobQueue
+	{
+	public:
+		virtual ~BJobQueue(void) = default;
+
+		virtual void push(BJobNode* node) = 0;
+		virtual void erase(BJobNode* node) = 0;
+		virtual BJobNode* pop_expired(BTimePoint now) = 0;
+		virtual BJobNode* take_all(void) = 0;		// chained by '_next'.
+		virtual BTimePoint next_deadline(void) const = 0;
+
+	};
+
+
 	//--------------------------------------------------------------------
 	//	extern global entries.
 	//--------------------------------------------------------------------
@@ -94,6 +167,15 @@ namespace agave::details
 
 	//--------------------------------------------------------------------
 	//	job scheduler.
+	//	* the pending jobs are sharded, each shard has its own lock, queue
+	//	  and expiry thread, new jobs go to the shard of the current thread.
+	//	* the tokens and the links tell the shard of their jobs.
+	//	* a job with slack may fire up to 'slack' late, its deadline is
+	//	  coalesced with the close ones, which then fire by one wakeup.
+	//	* all of the jobs expired by one wakeup are dispatched to the job
+	//	  executor as one batch.
+	//	* the expiry threads wait on a condition variable, or on a timerfd
+	//	  by epoll_wait on Linux, which is precise to the microseconds.
 	//--------------------------------------------------------------------
 	class BJobScheduler : public espresso::utilities::B_Object<BJobScheduler>
 	{
@@ -101,14 +183,36 @@ namespace agave::details
 
 	public:
 		static auto instance_ptr(void) -> std::shared_ptr<BJobScheduler>;
+		static auto instance(void) -> BJobScheduler*;
 		static void destroy_instance(void);
+		static bool select_backend(BJobBackend backend);
+		static bool select_shards(unsigned count);
+		static bool select_timer(BJobTimer timer);
+		static bool select_tolerance(BDuration tolerance);
 
-		BJobToken add_job(BDuration dur, BCallBack cb);
+		BJobToken add_job(BDuration dur, BCallBack cb, BDuration slack = BDuration::zero());
+		BJobToken add_job_at(BTimePoint tp, BCallBack cb, BDuration slack = BDuration::zero());
 		bool remove_job(BJobToken const& tok);
+		std::size_t remove_jobs(std::span<BJobToken> toks);
 		bool clear_all_jobs(void);
 
+		void add_job(BDuration dur, BJobNode* node, BDuration slack = BDuration::zero());
+		void add_job_at(BTimePoint tp, BJobNode* node, BDuration slack = BDuration::zero());
+		std::size_t remove_jobs(std::span<BJobNode** const> links, std::span<BJobNode*> removed);
+
+		static void dispatch(BWorkBatch& batch);
+
+		static BTimePoint coalesce(BTimePoint tp, BDuration slack) noexcept;
+		std::size_t wakeups(void) const noexcept;
+
 	private:
-		BJobScheduler(void);
+		class shard_t;
+
+		BJobScheduler(
+			BJobBackend backend,
+			unsigned shard_count,
+			BJobTimer timer,
+			BDuration tolerance);
 
 		BJobScheduler(BJobScheduler const& other) = delete;
 		BJobScheduler(BJobScheduler&& other) = delete;
@@ -116,25 +220,38 @@ namespace agave::details
 
 		~BJobScheduler(void);
 
+		auto local_shard(void) -> shard_t&;
+		auto shard_of(BJobToken const& tok) const -> shard_t*;
+		auto shard_of(BJobNode** link) const -> shard_t&;
 		auto insert_new_job(
-			BDuration& dur,
+			shard_t& shard,
+			BTimePoint tp,
 			BCallBack& fn) -> BJobToken;
-		void insert_new_job(std::tuple<BJobToken, BTimePoint, BCallBack> task_tup);
-		bool remove_job_by_token(BJobToken const& tok);
-		void loop_jobs(void);
+		bool remove_job_by_token(shard_t& shard, BJobToken const& tok);
+		void discard_node(shard_t& shard, BJobNode* node, std::vector<BJobNode*>& dropped);
+		auto find_node(shard_t const& shard, BJobToken const& tok) const -> BJobNode*;
+		auto acquire_node(shard_t& shard) -> BJobNode*;
+		void release_node(shard_t& shard, BJobNode* node);
+		void dispatch(shard_t& shard, BWorkBatch& batch);
+		void wake_up(shard_t& shard, BTimePoint tp);
+		void wait_for(shard_t& shard, std::unique_lock<std::mutex>& lck, BTimePoint deadline);
+		void loop_jobs(shard_t& shard);
 
 	private:
 		static std::shared_ptr<BJobScheduler>			_b_job_scheduler;
+		static std::atomic<BJobScheduler*>				_instance;		// published under '_instance_mx'.
 		static std::mutex								_instance_mx;
-		static unsigned long long						_next_tok_id;
-
-		std::mutex										_mx;
-		std::condition_variable							_cv;
-		std::list<std::tuple<BJobToken, BTimePoint, BCallBack>>
-			_pending_jobs;
-		std::tuple<BJobToken, BTimePoint, BCallBack>	_cur_item{ nullptr, std::chrono::high_resolution_clock::now(), nullptr };
+		static bool										_is_closed;		// ditto, while no instance is made.
+		static BJobBackend								_backend;
+		static unsigned									_shard_count;		// 0 for one per hardware thread.
+		static BJobTimer								_timer;
+		static BDuration								_tolerance;		// resolution of the timing wheel.
+		static constexpr unsigned						_chunk_bits{ 8u };
+		static constexpr unsigned						_shard_bits{ 8u };
+		static constexpr unsigned						_index_bits{ 24u };		// of the slot in the tokens.
+
+		std::vector<std::unique_ptr<shard_t>>			_shards;
 		std::atomic<bool>								_is_exit{ false };
-		std::thread										_th;
 
 
 	};
@@ -0,0 +1,777 @@
+//--------------------------------------------------------------------
+//	BThreadPool.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Thread Pool - A Part of Agave(TM) Coroutine Framework 
+//		(based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "BThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <bit>
+#include <condition_variable>
+#include <utility>
+
+
+//--------------------------------------------------------------------
+// initialize static variables.
+//--------------------------------------------------------------------
+constinit std::shared_ptr<agave::details::BThreadPool> agave::details::BThreadPool::_b_thread_pool{ nullptr };
+constinit std::atomic<agave::details::BThreadPool*> agave::details::BThreadPool::_instance{ nullptr };
+std::mutex agave::details::BThreadPool::_instance_mx;
+constinit bool agave::details::BThreadPool::_is_closed{ false };
+
+
+//--------------------------------------------------------------------
+namespace agave::details
+{
+	//--------------------------------------------------------------------
+	//	ring buffer of the deque, only the owner grows it.
+	//--------------------------------------------------------------------
+	class BWorkDeque::ring_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		ring_t(long long capacity) :
+			_mask{ capacity - 1 }, _items{ new std::atomic<void*>[static_cast<std::size_t>(capacity)] }
+		{
+			//
+		}
+
+		//--------------------------------------------------------------------
+		long long capacity(void) const noexcept
+		{
+			return _mask + 1;
+		}
+
+		//--------------------------------------------------------------------
+		void put(long long index, void* item) noexcept
+		{
+			_items[index & _mask].store(item, std::memory_order::relaxed);
+		}
+
+		//--------------------------------------------------------------------
+		void* get(long long index) const noexcept
+		{
+			return _items[index & _mask].load(std::memory_order::relaxed);
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		long long										_mask;
+		std::unique_ptr<std::atomic<void*>[]>			_items;
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	worker thread with its own deque.
+	//--------------------------------------------------------------------
+	class BThreadPool::worker_t
+	{
+	public:
+		BWorkDeque										_deque;
+		std::thread										_th;
+		unsigned										_victim{ 0u };		// where to steal next.
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	deletes the pools released on their own workers, by one thread,
+	//	which is joined with the statics at exit.
+	//--------------------------------------------------------------------
+	class BThreadPool::reaper_t
+	{
+	public:
+		//--------------------------------------------------------------------
+		~reaper_t(void)
+		{
+			std::unique_lock lck(_mx);
+			_is_exit = true;
+			_cv.notify_all();
+			lck.unlock();
+
+			if (_th.joinable())
+				_th.join();
+		}
+
+		//--------------------------------------------------------------------
+		void add(BThreadPool* p)
+		{
+			std::unique_lock lck(_mx);
+			_pools.push_back(p);
+			++_pending;
+			_cv.notify_all();
+
+			if (!_th.joinable())
+				_th = std::thread([this] { loop(); });
+		}
+
+		//--------------------------------------------------------------------
+		//	waits for the pools added so far to be deleted, unless called by
+		//	the reaper itself.
+		//--------------------------------------------------------------------
+		void wait(void)
+		{
+			std::unique_lock lck(_mx);
+			if (_th.get_id() == std::this_thread::get_id())
+				return;
+
+			_cv.wait(lck, [this] { return !_pending; });
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		//--------------------------------------------------------------------
+		void loop(void)
+		{
+			std::unique_lock lck(_mx);
+			for (;;)
+			{
+				_cv.wait(lck, [this] { return _is_exit || !_pools.empty(); });
+				if (_pools.empty())
+					return;
+
+				auto p = _pools.back();
+				_pools.pop_back();
+				lck.unlock();
+				delete p;
+				lck.lock();
+
+				--_pending;
+				_cv.notify_all();
+			}
+		}
+
+		//--------------------------------------------------------------------
+
+	private:
+		std::mutex										_mx;
+		std::condition_variable							_cv;
+		std::vector<BThreadPool*>						_pools;
+		std::size_t										_pending{ 0u };
+		bool											_is_exit{ false };
+		std::thread										_th;
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	work item wrapping a std::function.
+	//--------------------------------------------------------------------
+	class func_item_t : public BWorkItem
+	{
+	public:
+		std::function<void(void)>						_fn;
+
+	};
+
+
+	//--------------------------------------------------------------------
+	inline auto new_func_item(std::function<void(void)> fn) -> BWorkItem*
+	{
+		auto item = new func_item_t;
+		item->_fn = std::move(fn);
+		item->_run = [](BWorkItem* w)
+			{
+				std::unique_ptr<func_item_t> self{ static_cast<func_item_t*>(w) };
+				self->_fn();
+			};
+
+		return item;
+	}
+
+
+	//--------------------------------------------------------------------
+	//	the worker (and its pool) running on the current thread.
+	//--------------------------------------------------------------------
+	static thread_local BThreadPool*					__tls_pool{ nullptr };
+	static thread_local void*							__tls_worker{ nullptr };
+
+	//--------------------------------------------------------------------
+
+
+}
+
+
+//--------------------------------------------------------------------
+agave::details::BThreadPool::reaper_t agave::details::BThreadPool::_reaper;
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BWorkBatch::add(std::coroutine_handle<> h)
+{
+	_items.push_back(h.address());
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BWorkBatch::add(BWorkItem* item)
+{
+	_items.push_back(reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(item) | 1u));
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BWorkBatch::add(std::function<void(void)> fn)
+{
+	add(new_func_item(std::move(fn)));
+}
+
+
+//--------------------------------------------------------------------
+std::size_t
+agave::details::BWorkBatch::size(void)
+const noexcept
+{
+	return _items.size();
+}
+
+
+//--------------------------------------------------------------------
+bool
+agave::details::BWorkBatch::empty(void)
+const noexcept
+{
+	return _items.empty();
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BWorkBatch::clear(void)
+noexcept
+{
+	_items.clear();
+}
+
+
+//--------------------------------------------------------------------
+//	runs one of the tagged items.
+//--------------------------------------------------------------------
+void
+agave::details::BWorkBatch::run(void* item)
+{
+	auto bits = reinterpret_cast<std::uintptr_t>(item);
+
+	if (bits & 1u)
+	{
+		auto work = reinterpret_cast<BWorkItem*>(bits & ~std::uintptr_t{ 1u });
+		work->_run(work);
+	}
+	else
+		std::coroutine_handle<>::from_address(item).resume();
+
+}
+
+
+//--------------------------------------------------------------------
+agave::details::BWorkDeque::BWorkDeque(void)
+{
+	auto& ring = _retired.emplace_back(std::make_unique<ring_t>(256));
+	_ring.store(ring.get(), std::memory_order::relaxed);
+}
+
+
+//--------------------------------------------------------------------
+agave::details::BWorkDeque::~BWorkDeque(void)
+{
+	//
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BWorkDeque::push(void* item)
+{
+	auto bottom = _bottom.load(std::memory_order::relaxed);
+	auto top = _top.load(std::memory_order::acquire);
+	auto ring = _ring.load(std::memory_order::relaxed);
+
+	if (bottom - top > ring->capacity() - 1)
+	{
+		grow(top, bottom);
+		ring = _ring.load(std::memory_order::relaxed);
+	}
+
+	ring->put(bottom, item);
+	std::atomic_thread_fence(std::memory_order::release);
+	_bottom.store(bottom + 1, std::memory_order::relaxed);
+
+}
+
+
+//--------------------------------------------------------------------
+void*
+agave::details::BWorkDeque::take(void)
+{
+	auto bottom = _bottom.load(std::memory_order::relaxed) - 1;
+	auto ring = _ring.load(std::memory_order::relaxed);
+	_bottom.store(bottom, std::memory_order::relaxed);
+	std::atomic_thread_fence(std::memory_order::seq_cst);
+	auto top = _top.load(std::memory_order::relaxed);
+
+	void* item = nullptr;
+	if (top <= bottom)
+	{
+		item = ring->get(bottom);
+		if (top == bottom)	// the last item, race with the thieves.
+		{
+			if (!_top.compare_exchange_strong(top, top + 1,
+				std::memory_order::seq_cst, std::memory_order::relaxed))
+				item = nullptr;
+
+			_bottom.store(bottom + 1, std::memory_order::relaxed);
+		}
+
+	}
+	else
+		_bottom.store(bottom + 1, std::memory_order::relaxed);
+
+	return item;
+
+}
+
+
+//--------------------------------------------------------------------
+void*
+agave::details::BWorkDeque::steal(void)
+{
+	auto top = _top.load(std::memory_order::acquire);
+	std::atomic_thread_fence(std::memory_order::seq_cst);
+	auto bottom = _bottom.load(std::memory_order::acquire);
+
+	if (top < bottom)
+	{
+		auto item = _ring.load(std::memory_order::acquire)->get(top);
+		if (_top.compare_exchange_strong(top, top + 1,
+			std::memory_order::seq_cst, std::memory_order::relaxed))
+			return item;
+	}
+
+	return nullptr;
+
+}
+
+
+//--------------------------------------------------------------------
+bool
+agave::details::BWorkDeque::empty(void)
+const
+{
+	return _bottom.load(std::memory_order::relaxed) <= _top.load(std::memory_order::relaxed);
+}
+
+
+//--------------------------------------------------------------------
+//	the retired rings are kept alive until the deque is destroyed,
+//	since a thief may still read from them.
+//--------------------------------------------------------------------
+void
+agave::details::BWorkDeque::grow(long long top, long long bottom)
+{
+	auto ring = _ring.load(std::memory_order::relaxed);
+	auto& bigger = _retired.emplace_back(std::make_unique<ring_t>(ring->capacity() * 2));
+
+	for (auto i = top; i < bottom; ++i)
+		bigger->put(i, ring->get(i));
+
+	_ring.store(bigger.get(), std::memory_order::release);
+
+}
+
+
+//--------------------------------------------------------------------
+//	made on first use, and made again after destroy_instance(), but
+//	not while the instance is destroyed, nor once the statics are.
+//--------------------------------------------------------------------
+auto
+agave::details::BThreadPool::instance_ptr(void) ->
+std::shared_ptr<agave::details::BThreadPool>
+{
+	std::unique_lock lck{ _instance_mx };
+	if (!_b_thread_pool && !_is_closed)
+	{
+		_b_thread_pool = espresso::utilities::make_obj<BThreadPool>(
+			&BThreadPool::delete_self, std::max(2u, std::thread::hardware_concurrency()));
+		_instance.store(_b_thread_pool.get(), std::memory_order::release);
+	}
+
+	return _b_thread_pool;
+
+}
+
+
+//--------------------------------------------------------------------
+//	the raw pointer, without touching the reference count, 'nullptr'
+//	when instance_ptr() makes none.
+//--------------------------------------------------------------------
+auto
+agave::details::BThreadPool::instance(void) ->
+agave::details::BThreadPool*
+{
+	if (auto p = _instance.load(std::memory_order::acquire))
+		return p;
+
+	return instance_ptr().get();
+
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BThreadPool::destroy_instance(void)
+{
+	std::unique_lock lck(_instance_mx);
+	auto p = std::exchange(_b_thread_pool, nullptr);
+	_instance.store(nullptr, std::memory_order::release);
+	_is_closed = true;
+	lck.unlock();
+
+	// destroyed without the lock, the calls meanwhile get no instance,
+	// rather than a new one.
+	p = nullptr;
+
+	lck.lock();
+	_is_closed = false;
+
+	lck.unlock();
+
+	// the pools released on their own workers are gone too, unless this
+	// is one of those workers.
+	if (!__tls_pool)
+		_reaper.wait();
+
+}
+
+
+//--------------------------------------------------------------------
+//	a pool of its own, e.g. for the blocking calls, it's released with
+//	the last reference.
+//--------------------------------------------------------------------
+auto
+agave::details::BThreadPool::create(unsigned worker_count) ->
+std::shared_ptr<agave::details::BThreadPool>
+{
+	return espresso::utilities::make_obj<BThreadPool>(
+		&BThreadPool::delete_self, std::max(1u, worker_count));
+}
+
+
+//--------------------------------------------------------------------
+auto
+agave::details::BThreadPool::schedule(void) noexcept ->
+agave::details::BThreadPool::schedule_awaiter_t
+{
+	return { this };
+}
+
+
+//--------------------------------------------------------------------
+//	resumes the coroutine on the pool, no allocation.
+//--------------------------------------------------------------------
+void
+agave::details::BThreadPool::submit(std::coroutine_handle<> h)
+{
+	push(h.address());
+}
+
+
+//--------------------------------------------------------------------
+//	runs the intrusive item on the pool, no allocation.
+//--------------------------------------------------------------------
+void
+agave::details::BThreadPool::submit(BWorkItem* item)
+{
+	push(reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(item) | 1u));
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BThreadPool::submit(std::function<void(void)> fn)
+{
+	submit(new_func_item(std::move(fn)));
+}
+
+
+//--------------------------------------------------------------------
+//	pushes the whole batch under one lock and one wakeup, the batch is
+//	left untouched.
+//--------------------------------------------------------------------
+void
+agave::details::BThreadPool::submit(BWorkBatch& batch)
+{
+	if (!batch.empty())
+		push(batch._items.data(), batch._items.size());
+}
+
+
+//--------------------------------------------------------------------
+std::size_t
+agave::details::BThreadPool::worker_count(void)
+const noexcept
+{
+	return _workers.size();
+}
+
+
+//--------------------------------------------------------------------
+agave::details::BThreadPool::BThreadPool(unsigned worker_count)
+{
+	for (auto i = 0u; i < worker_count; ++i)
+	{
+		auto& worker = _workers.emplace_back(std::make_unique<worker_t>());
+		worker->_victim = i + 1u;
+	}
+
+	for (auto& worker : _workers)
+		worker->_th = std::thread([this, self = worker.get()] { loop_worker(*self); });
+
+}
+
+
+//--------------------------------------------------------------------
+//	the last reference may go away on one of the workers, which goes on
+//	running the loop of the pool, the reaper deletes it then.
+//--------------------------------------------------------------------
+void
+agave::details::BThreadPool::delete_self(BThreadPool* p)
+{
+	if (!p)
+		return;
+
+	// still published, the static itself went away at exit.
+	std::unique_lock lck(_instance_mx);
+	if (_instance.load(std::memory_order::relaxed) == p)
+	{
+		_instance.store(nullptr, std::memory_order::release);
+		_is_closed = true;
+	}
+
+	lck.unlock();
+
+	if (__tls_pool == p)
+		_reaper.add(p);
+	else
+		delete p;
+
+}
+
+
+//--------------------------------------------------------------------
+//	joins the workers, then runs the items left on this thread, with
+//	the ones they push meanwhile, none of them is dropped.
+//--------------------------------------------------------------------
+agave::details::BThreadPool::~BThreadPool(void)
+{
+	std::unique_lock lck(_inject_mx);	// waits for the injecting threads.
+	lck.unlock();
+
+	_is_exit.store(true, std::memory_order::seq_cst);
+	_epoch.fetch_add(1u, std::memory_order::seq_cst);
+	_epoch.notify_all();
+
+	for (auto& worker : _workers)
+	{
+		if (worker->_th.joinable())
+			worker->_th.join();
+	}
+
+	while (auto item = pop_left())
+		BWorkBatch::run(item);
+
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BThreadPool::push(void* item)
+{
+	push(&item, 1u);
+}
+
+
+//--------------------------------------------------------------------
+//	* items are tagged pointers: a coroutine frame address, or a
+//	  BWorkItem pointer with the lowest bit set.
+//	* the workers push into their own deques, the others inject.
+//	* the injecting threads wake up the workers under the lock, since
+//	  the pool may go away as soon as the items ran, the destructor
+//	  takes the lock first.
+//--------------------------------------------------------------------
+void
+agave::details::BThreadPool::push(void* const* items, std::size_t count)
+{
+	if (__tls_pool == this)
+	{
+		auto& deque = static_cast<worker_t*>(__tls_worker)->_deque;
+		for (std::size_t i = 0u; i < count; ++i)
+			deque.push(items[i]);
+
+		wake_up(count);
+	}
+	else
+	{
+		std::unique_lock lck(_inject_mx);
+		auto injected = _injected_count.load(std::memory_order::relaxed);
+		if (injected + count > _injected.size())	// unrolls the ring into a bigger one.
+		{
+			std::vector<void*> bigger(std::bit_ceil(std::max<std::size_t>(64u, (injected + count) * 2u)));
+			for (std::size_t i = 0u; i < injected; ++i)
+				bigger[i] = _injected[(_inject_head + i) & (_injected.size() - 1u)];
+
+			_injected.swap(bigger);
+			_inject_head = 0u;
+		}
+
+		for (std::size_t i = 0u; i < count; ++i)
+			_injected[(_inject_head + injected + i) & (_injected.size() - 1u)] = items[i];
+
+		_injected_count.fetch_add(count, std::memory_order::release);
+		wake_up(count);
+	}
+
+}
+
+
+//--------------------------------------------------------------------
+//	a batch bumps the epoch once, and wakes up as many sleepers as it
+//	may keep busy.
+//--------------------------------------------------------------------
+void
+agave::details::BThreadPool::wake_up(std::size_t count)
+{
+	_epoch.fetch_add(1u, std::memory_order::seq_cst);
+	if (_sleepers.load(std::memory_order::seq_cst))
+	{
+		if (count > 1u)
+			_epoch.notify_all();
+		else
+			_epoch.notify_one();
+	}
+
+}
+
+
+//--------------------------------------------------------------------
+void*
+agave::details::BThreadPool::pop_injected(void)
+{
+	if (!_injected_count.load(std::memory_order::acquire))
+		return nullptr;
+
+	std::unique_lock lck(_inject_mx);
+	if (!_injected_count.load(std::memory_order::relaxed))
+		return nullptr;
+
+	auto item = _injected[_inject_head];
+	_inject_head = (_inject_head + 1u) & (_injected.size() - 1u);
+	_injected_count.fetch_sub(1u, std::memory_order::relaxed);
+
+	return item;
+
+}
+
+
+//--------------------------------------------------------------------
+//	the items left in the deques, then in the injection ring, once the
+//	workers are gone.
+//--------------------------------------------------------------------
+void*
+agave::details::BThreadPool::pop_left(void)
+{
+	for (auto& worker : _workers)
+	{
+		if (auto item = worker->_deque.take())
+			return item;
+	}
+
+	return pop_injected();
+
+}
+
+
+//--------------------------------------------------------------------
+void*
+agave::details::BThreadPool::find_work(worker_t& self)
+{
+	if (auto item = self._deque.take())
+		return item;
+
+	if (auto item = pop_injected())
+		return item;
+
+	auto count = static_cast<unsigned>(_workers.size());
+	for (auto i = 0u; i < count; ++i)
+	{
+		auto& victim = *_workers[self._victim++ % count];
+		if (&victim == &self)
+			continue;
+
+		if (auto item = victim._deque.steal())
+			return item;
+	}
+
+	return nullptr;
+
+}
+
+
+//--------------------------------------------------------------------
+void
+agave::details::BThreadPool::loop_worker(worker_t& self)
+{
+	__tls_pool = this;
+	__tls_worker = &self;
+
+	while (!_is_exit.load(std::memory_order::acquire))
+	{
+		auto item = find_work(self);
+
+		// spin a little before going to sleep.
+		for (auto spin = 0; !item && spin < 64; ++spin)
+		{
+			std::this_thread::yield();
+			item = find_work(self);
+		}
+
+		if (item)
+		{
+			BWorkBatch::run(item);
+			continue;
+		}
+
+		// check again after registering as a sleeper, any work pushed
+		// later bumps the epoch and wakes one of the sleepers.
+		auto epoch = _epoch.load(std::memory_order::seq_cst);
+		_sleepers.fetch_add(1u, std::memory_order::seq_cst);
+
+		item = find_work(self);
+		if (!item && !_is_exit.load(std::memory_order::seq_cst))
+			_epoch.wait(epoch, std::memory_order::seq_cst);
+
+		_sleepers.fetch_sub(1u, std::memory_order::seq_cst);
+
+		if (item)
+			BWorkBatch::run(item);
+
+	}
+
+	__tls_pool = nullptr;
+	__tls_worker = nullptr;
+
+}
+
+
+//--------------------------------------------------------------------
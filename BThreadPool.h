@@ -0,0 +1,192 @@
+//--------------------------------------------------------------------
+//	BThreadPool.h.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Thread Pool - A Part of Agave(TM) Coroutine Framework 
+//		(based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#pragma once
+
+#ifndef _BTHREAD_POOL_H__
+#define _BTHREAD_POOL_H__
+
+
+//--------------------------------------------------------------------
+//	headers.
+//--------------------------------------------------------------------
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <coroutine>
+#include "B_Object.hpp"
+
+
+//--------------------------------------------------------------------
+namespace agave::details
+{
+	//--------------------------------------------------------------------
+	//	intrusive work item, runs without any allocation by the pool.
+	//--------------------------------------------------------------------
+	class BWorkItem
+	{
+	public:
+		void									(*_run)(BWorkItem* item) { nullptr };
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	work collected to be submitted at once, see BThreadPool::submit.
+	//	* items are tagged pointers, see BThreadPool.
+	//--------------------------------------------------------------------
+	class BWorkBatch
+	{
+	public:
+		void add(std::coroutine_handle<> h);
+		void add(BWorkItem* item);
+		void add(std::function<void(void)> fn);
+
+		std::size_t size(void) const noexcept;
+		bool empty(void) const noexcept;
+		void clear(void) noexcept;
+
+		static void run(void* item);
+
+	public:
+		std::vector<void*>								_items;
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	Chase-Lev work stealing deque, the owner pushes and takes at the
+	//	bottom, the thieves steal at the top.
+	//	* items are tagged pointers, see BThreadPool.
+	//--------------------------------------------------------------------
+	class BWorkDeque
+	{
+	public:
+		BWorkDeque(void);
+		~BWorkDeque(void);
+
+		BWorkDeque(BWorkDeque const& other) = delete;
+		BWorkDeque& operator = (BWorkDeque const& other) = delete;
+
+		void push(void* item);
+		void* take(void);
+		void* steal(void);
+		bool empty(void) const;
+
+	private:
+		class ring_t;
+
+		void grow(long long top, long long bottom);
+
+	private:
+		std::atomic<long long>							_top{ 0 };
+		std::atomic<long long>							_bottom{ 0 };
+		std::atomic<ring_t*>							_ring;
+		std::vector<std::unique_ptr<ring_t>>			_retired;		// freed with the deque.
+
+	};
+
+
+	//--------------------------------------------------------------------
+	//	work stealing thread pool, the default background / job executor.
+	//	* each worker owns a Chase-Lev deque, the work submitted from the
+	//	  other threads goes through the global injection queue.
+	//	* idle workers steal from the others before going to sleep.
+	//	* more pools can be created besides the instance, 'co_await
+	//	  pool.schedule()' resumes on the pool (see agave::resume_on).
+	//	* a pool runs the work left in it before it goes away, even if
+	//	  the last reference is released on one of its own workers.
+	//--------------------------------------------------------------------
+	class BThreadPool : public espresso::utilities::B_Object<BThreadPool>
+	{
+		DefineMakeObjFriend;
+
+	public:
+		//--------------------------------------------------------------------
+		class schedule_awaiter_t
+		{
+		public:
+			bool await_ready(void) const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<> h) const { _pool->submit(h); }
+			void await_resume(void) const noexcept {}
+
+		public:
+			BThreadPool*								_pool;
+
+		};
+
+		//--------------------------------------------------------------------
+
+	public:
+		static auto instance_ptr(void) -> std::shared_ptr<BThreadPool>;
+		static auto instance(void) -> BThreadPool*;
+		static void destroy_instance(void);
+		static auto create(unsigned worker_count) -> std::shared_ptr<BThreadPool>;
+
+		auto schedule(void) noexcept -> schedule_awaiter_t;
+		void submit(std::coroutine_handle<> h);
+		void submit(BWorkItem* item);
+		void submit(std::function<void(void)> fn);
+		void submit(BWorkBatch& batch);
+
+		std::size_t worker_count(void) const noexcept;
+
+	private:
+		class worker_t;
+		class reaper_t;
+
+		BThreadPool(unsigned worker_count);
+
+		BThreadPool(BThreadPool const& other) = delete;
+		BThreadPool(BThreadPool&& other) = delete;
+		static void delete_self(BThreadPool* p);
+
+		~BThreadPool(void);
+
+		void push(void* item);
+		void push(void* const* items, std::size_t count);
+		void wake_up(std::size_t count);
+		void* pop_injected(void);
+		void* pop_left(void);
+		void* find_work(worker_t& self);
+		void loop_worker(worker_t& self);
+
+	private:
+		static std::shared_ptr<BThreadPool>				_b_thread_pool;
+		static std::atomic<BThreadPool*>				_instance;		// published under '_instance_mx'.
+		static std::mutex								_instance_mx;
+		static bool										_is_closed;		// ditto, while no instance is made.
+		static reaper_t									_reaper;
+
+		std::vector<std::unique_ptr<worker_t>>			_workers;
+		std::mutex										_inject_mx;
+		std::vector<void*>								_injected;		// ring, power of 2 sized.
+		std::size_t										_inject_head{ 0u };
+		std::atomic<std::size_t>						_injected_count{ 0u };
+		std::atomic<unsigned>							_epoch{ 0u };
+		std::atomic<unsigned>							_sleepers{ 0u };
+		std::atomic<bool>								_is_exit{ false };
+
+
+	};
+
+
+	//--------------------------------------------------------------------
+
+
+}
+
+
+//--------------------------------------------------------------------
+#endif // !_BTHREAD_POOL_H__
@@ -0,0 +1,245 @@
+//--------------------------------------------------------------------
+//	bench_alloc.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Heap allocations per coroutine call - A Part of Agave(TM)
+//		Coroutine Framework (based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+
+
+//--------------------------------------------------------------------
+//	counts every call of the global operator new, all of the forms go
+//	through the same pair of functions, which the deletes free by.
+//--------------------------------------------------------------------
+static std::atomic<std::size_t> __heap_allocs{ 0u };
+
+static void* counted_alloc(std::size_t size, std::size_t align) noexcept
+{
+	__heap_allocs.fetch_add(1u, std::memory_order::relaxed);
+
+	size = size ? size : 1u;
+	if (align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		return std::malloc(size);
+
+	return std::aligned_alloc(align, (size + align - 1u) / align * align);
+}
+
+static void counted_free(void* p) noexcept
+{
+	std::free(p);
+}
+
+static void* counted_new(std::size_t size, std::size_t align)
+{
+	if (auto p = counted_alloc(size, align))
+		return p;
+
+	throw std::bad_alloc{};
+}
+
+void* operator new(std::size_t size) { return counted_new(size, 0u); }
+void* operator new[](std::size_t size) { return counted_new(size, 0u); }
+void* operator new(std::size_t size, std::align_val_t al) { return counted_new(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al) { return counted_new(size, static_cast<std::size_t>(al)); }
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept { return counted_alloc(size, 0u); }
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept { return counted_alloc(size, 0u); }
+void* operator new(std::size_t size, std::align_val_t al, std::nothrow_t const&) noexcept { return counted_alloc(size, static_cast<std::size_t>(al)); }
+void* operator new[](std::size_t size, std::align_val_t al, std::nothrow_t const&) noexcept { return counted_alloc(size, static_cast<std::size_t>(al)); }
+
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::nothrow_t const&) noexcept { counted_free(p); }
+void operator delete[](void* p, std::nothrow_t const&) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t, std::nothrow_t const&) noexcept { counted_free(p); }
+void operator delete[](void* p, std::align_val_t, std::nothrow_t const&) noexcept { counted_free(p); }
+
+
+//--------------------------------------------------------------------
+using bench_clock = std::chrono::steady_clock;
+
+
+//--------------------------------------------------------------------
+agave::AsyncAction
+short_action_async(void)
+{
+	co_return;
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+short_operation_async(int v)
+{
+	co_return v + 1;
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+nested_operation_async(int v)
+{
+	co_await short_action_async();
+	auto&& r = co_await short_operation_async(v);
+	co_return r + 1;
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncAction
+sleep_async(int n)
+{
+	for (int i = 0; i < n; ++i)
+		co_await std::chrono::milliseconds(1);
+}
+
+
+//--------------------------------------------------------------------
+class record_t
+{
+public:
+	long long									_id;
+	double										_values[6];
+
+};
+
+
+//--------------------------------------------------------------------
+agave::AsyncGenerator<record_t>
+records_async(int n)
+{
+	record_t record{};
+	for (int i = 0; i < n; ++i)
+	{
+		record._id = i;
+		co_yield record;	// not copied, the consumer reads it in place.
+	}
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<long long>
+sum_records_async(int n)
+{
+	long long sum = 0;
+	auto records = records_async(n);
+
+	while (auto record = co_await records.next())
+		sum += record->_id;
+
+	co_return sum;
+}
+
+
+//--------------------------------------------------------------------
+//	runs the call N times after a warm up, and reports the heap
+//	allocations and the time per call.
+//--------------------------------------------------------------------
+template <typename Fn>
+static void bench_calls(char const* name, Fn&& fn)
+{
+	constexpr std::size_t warm_up = 1'000u;
+	constexpr std::size_t calls = 1'000'000u;
+
+	for (std::size_t i = 0u; i < warm_up; ++i)
+		fn(i);
+
+	auto allocs = __heap_allocs.load(std::memory_order::relaxed);
+	auto t0 = bench_clock::now();
+
+	for (std::size_t i = 0u; i < calls; ++i)
+		fn(i);
+
+	auto elapsed = bench_clock::now() - t0;
+	allocs = __heap_allocs.load(std::memory_order::relaxed) - allocs;
+
+	std::cout << std::left << std::setw(20) << name
+		<< std::right << std::setw(14) << std::fixed << std::setprecision(3)
+		<< static_cast<double>(allocs) / calls
+		<< std::setw(14) << std::chrono::duration<double, std::nano>(elapsed).count() / calls
+		<< std::endl;
+
+}
+
+
+//--------------------------------------------------------------------
+//	one coroutine sleeping N times, reports the heap allocations and
+//	the time per sleep.
+//--------------------------------------------------------------------
+static void bench_sleeps(char const* name, int sleeps)
+{
+	sleep_async(10).get();		// warm up the scheduler and the pool.
+
+	auto allocs = __heap_allocs.load(std::memory_order::relaxed);
+	auto t0 = bench_clock::now();
+
+	sleep_async(sleeps).get();
+
+	auto elapsed = bench_clock::now() - t0;
+	allocs = __heap_allocs.load(std::memory_order::relaxed) - allocs;
+
+	std::cout << std::left << std::setw(20) << name
+		<< std::right << std::setw(14) << std::fixed << std::setprecision(3)
+		<< static_cast<double>(allocs) / sleeps
+		<< std::setw(14) << std::chrono::duration<double, std::nano>(elapsed).count() / sleeps
+		<< std::endl;
+
+}
+
+
+//--------------------------------------------------------------------
+//	one generator streaming N records to one consumer, reports the
+//	heap allocations and the time per record.
+//--------------------------------------------------------------------
+static void bench_stream(char const* name, int records)
+{
+	sum_records_async(10).get();
+
+	auto allocs = __heap_allocs.load(std::memory_order::relaxed);
+	auto t0 = bench_clock::now();
+
+	auto sum = sum_records_async(records).get();
+
+	auto elapsed = bench_clock::now() - t0;
+	allocs = __heap_allocs.load(std::memory_order::relaxed) - allocs;
+
+	std::cout << std::left << std::setw(20) << name
+		<< std::right << std::setw(14) << std::fixed << std::setprecision(3)
+		<< static_cast<double>(allocs) / records
+		<< std::setw(14) << std::chrono::duration<double, std::nano>(elapsed).count() / records
+		<< (sum == static_cast<long long>(records) * (records - 1) / 2 ? "" : "  (wrong sum)")
+		<< std::endl;
+
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	std::cout << "coroutine          allocs/call    ns/call" << std::endl;
+
+	bench_calls("AsyncAction", [](std::size_t) { short_action_async().get(); });
+	bench_calls("AsyncOperation", [](std::size_t i) { short_operation_async(static_cast<int>(i)).get(); });
+	bench_calls("nested (3 frames)", [](std::size_t i) { nested_operation_async(static_cast<int>(i)).get(); });
+	bench_sleeps("co_await 1ms", 1000);
+	bench_stream("generator item", 10'000'000);
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
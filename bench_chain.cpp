@@ -0,0 +1,200 @@
+//--------------------------------------------------------------------
+//	bench_chain.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Benchmarks of deep await chains - A Part of Agave(TM) Coroutine
+//		Framework (based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <iomanip>
+#include <future>
+
+
+//--------------------------------------------------------------------
+using bench_clock = std::chrono::steady_clock;
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+short_operation_async(int v)
+{
+	co_return v + 1;
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<long long>
+loop_async(int n)
+{
+	long long sum = 0;
+	for (int i = 0; i < n; ++i)
+		sum += co_await short_operation_async(i);
+
+	co_return sum;
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncAction
+gate_async(std::future<void> gate)
+{
+	co_await std::move(gate);
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncAction
+link_async(agave::AsyncAction inner)
+{
+	co_await inner;
+}
+
+
+//--------------------------------------------------------------------
+agave::Task<long long>
+descend_task(int depth)
+{
+	if (!depth)
+		co_return 0;
+
+	co_return 1 + co_await descend_task(depth - 1);
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncAction
+sleep_leaf_async(void)
+{
+	co_await std::chrono::hours(1);
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncAction
+fan_out_async(int depth, int fan)
+{
+	if (!depth)
+	{
+		co_await sleep_leaf_async();
+		co_return;
+	}
+
+	std::vector<agave::AsyncAction> children;
+	for (int i = 0; i < fan; ++i)
+		children.push_back(fan_out_async(depth - 1, fan));
+
+	co_await agave::when_all(children);
+}
+
+
+//--------------------------------------------------------------------
+//	1M co_await's of a coroutine completing synchronously in one loop.
+//--------------------------------------------------------------------
+static void bench_loop(int n)
+{
+	auto t0 = bench_clock::now();
+	loop_async(n).get();
+	auto elapsed = bench_clock::now() - t0;
+
+	std::cout << std::left << std::setw(12) << "tight loop"
+		<< std::right << std::setw(10) << n
+		<< std::setw(14) << std::fixed << std::setprecision(1)
+		<< std::chrono::duration<double, std::nano>(elapsed).count() / n << std::endl;
+
+}
+
+
+//--------------------------------------------------------------------
+//	N coroutines, each one awaits the previous one, then the innermost
+//	one completes and the completions run up through the whole chain
+//	synchronously on one thread.
+//--------------------------------------------------------------------
+static void bench_chain(int n)
+{
+	std::promise<void> gate;
+	auto chain = gate_async(gate.get_future());
+	for (int i = 0; i < n; ++i)
+		chain = link_async(chain);
+
+	auto t0 = bench_clock::now();
+	gate.set_value();
+	chain.get();
+	auto elapsed = bench_clock::now() - t0;
+
+	std::cout << std::left << std::setw(12) << "deep chain"
+		<< std::right << std::setw(10) << n
+		<< std::setw(14) << std::fixed << std::setprecision(1)
+		<< std::chrono::duration<double, std::nano>(elapsed).count() / n << std::endl;
+
+}
+
+
+//--------------------------------------------------------------------
+//	N lazy tasks, each one awaits the next one directly, both the
+//	descent and the completions run by symmetric transfer.
+//--------------------------------------------------------------------
+static void bench_task_chain(int n)
+{
+	auto t0 = bench_clock::now();
+	descend_task(n).get();
+	auto elapsed = bench_clock::now() - t0;
+
+	std::cout << std::left << std::setw(12) << "task chain"
+		<< std::right << std::setw(10) << n
+		<< std::setw(14) << std::fixed << std::setprecision(1)
+		<< std::chrono::duration<double, std::nano>(elapsed).count() / n << std::endl;
+
+}
+
+
+//--------------------------------------------------------------------
+//	a request tree of fan^depth sleeping leaves, cancel() walks the tree
+//	once and removes all of the sleeps, then the leaves drain.
+//--------------------------------------------------------------------
+static void bench_cancel_tree(int depth, int fan)
+{
+	auto leaves = 1;
+	for (int i = 0; i < depth; ++i)
+		leaves *= fan;
+
+	auto tree = fan_out_async(depth, fan);
+	std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+	auto t0 = bench_clock::now();
+	tree.cancel();
+	auto t1 = bench_clock::now();
+	tree.get();
+	auto t2 = bench_clock::now();
+
+	std::cout << std::left << std::setw(12) << "cancel tree"
+		<< std::right << std::setw(10) << leaves
+		<< std::setw(14) << std::fixed << std::setprecision(1)
+		<< std::chrono::duration<double, std::micro>(t1 - t0).count()
+		<< std::setw(14) << std::chrono::duration<double, std::micro>(t2 - t0).count() << std::endl;
+
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	std::cout << "bench            depth    ns/await" << std::endl;
+
+	bench_loop(1'000'000);
+	bench_chain(1'000'000);
+	bench_task_chain(1'000'000);
+
+	std::cout << std::endl << "bench           leaves   cancel (us)    drain (us)" << std::endl;
+
+	bench_cancel_tree(4, 10);
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
@@ -0,0 +1,122 @@
+//--------------------------------------------------------------------
+//	bench_channel.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Benchmarks of channels - A Part of Agave(TM)
+//		Coroutine Framework (based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <iomanip>
+#include <array>
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+using bench_clock = std::chrono::steady_clock;
+
+
+//--------------------------------------------------------------------
+//	the last producer done closes the channel.
+//--------------------------------------------------------------------
+agave::AsyncAction produce_async(agave::Channel<std::size_t>& channel, std::size_t count, std::atomic<std::size_t>& running)
+{
+	co_await agave::resume_background();
+
+	for (std::size_t i = 0; i < count; ++i)
+		co_await channel.send(i);
+
+	if (running.fetch_sub(1u) == 1u)
+		channel.close();
+
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<std::size_t> consume_async(agave::Channel<std::size_t>& channel, bool is_batched)
+{
+	co_await agave::resume_background();
+
+	std::size_t received = 0u;
+	std::array<std::size_t, 64> values;
+
+	while (true)
+	{
+		if (is_batched)
+		{
+			std::size_t count = co_await channel.receive_many(values);
+			if (!count)
+				break;
+
+			received += count;
+		}
+		else
+		{
+			auto value = co_await channel.receive();
+			if (!value)
+				break;
+
+			++received;
+		}
+	}
+
+	co_return received;
+}
+
+
+//--------------------------------------------------------------------
+//	N producers to 1 consumer, reports the messages per second.
+//--------------------------------------------------------------------
+static void bench_channel(char const* name, agave::Channel<std::size_t>& channel, std::size_t producers, std::size_t count, bool is_batched)
+{
+	std::atomic<std::size_t> running{ producers };
+	std::vector<agave::AsyncAction> actions;
+
+	auto t0 = bench_clock::now();
+
+	auto consumer = consume_async(channel, is_batched);
+	for (std::size_t i = 0; i < producers; ++i)
+		actions.push_back(produce_async(channel, count, running));
+
+	for (auto& action : actions)
+		action.get();
+
+	auto received = consumer.get();
+	auto seconds = std::chrono::duration<double>(bench_clock::now() - t0).count();
+
+	std::cout << std::left << std::setw(22) << name << std::right
+		<< std::setw(6) << producers
+		<< std::setw(12) << received
+		<< std::setw(14) << std::fixed << std::setprecision(2) << received / seconds / 1e6 << std::endl;
+
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	constexpr std::size_t count = 1'000'000u;
+
+	std::cout << "channel              producers  messages   M msgs/sec" << std::endl;
+
+	for (std::size_t producers : { 1u, 4u })
+	{
+		for (auto is_batched : { false, true })
+		{
+			agave::Channel<std::size_t> bounded{ 1024u };
+			bench_channel(is_batched ? "bounded, batched" : "bounded", bounded, producers, count, is_batched);
+
+			agave::Channel<std::size_t> unbounded;
+			bench_channel(is_batched ? "unbounded, batched" : "unbounded", unbounded, producers, count, is_batched);
+		}
+	}
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
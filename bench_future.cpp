@@ -0,0 +1,96 @@
+//--------------------------------------------------------------------
+//	bench_future.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Benchmarks of co_await'ing std::future - A Part of Agave(TM)
+//		Coroutine Framework (based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+using bench_clock = std::chrono::steady_clock;
+
+
+//--------------------------------------------------------------------
+//	the threads of the process, Linux only (0 elsewhere).
+//--------------------------------------------------------------------
+static std::size_t thread_count(void)
+{
+	std::ifstream status{ "/proc/self/status" };
+	for (std::string line; std::getline(status, line); )
+	{
+		if (line.rfind("Threads:", 0) == 0)
+			return std::stoul(line.substr(8));
+	}
+
+	return 0u;
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+await_future_async(std::future<int> future)
+{
+	co_return co_await std::move(future);
+}
+
+
+//--------------------------------------------------------------------
+//	N coroutines await N futures, which are fulfilled together after
+//	a while, reports the threads while they wait and how long it takes
+//	until all of them resumed.
+//--------------------------------------------------------------------
+static void bench_futures(std::size_t count)
+{
+	std::vector<std::promise<int>> promises(count);
+	std::vector<agave::AsyncOperation<int>> awaits;
+	awaits.reserve(count);
+
+	for (auto& promise : promises)
+		awaits.push_back(await_future_async(promise.get_future()));
+
+	std::this_thread::sleep_for(200ms);
+	auto threads = thread_count();
+
+	auto t0 = bench_clock::now();
+	for (auto& promise : promises)
+		promise.set_value(1);
+
+	long long sum = 0;
+	for (auto& await : awaits)
+		sum += await.get();
+
+	auto elapsed = bench_clock::now() - t0;
+
+	std::cout << std::right << std::setw(9) << count
+		<< std::setw(10) << threads
+		<< std::setw(14) << elapsed / 1us
+		<< std::setw(10) << (sum == static_cast<long long>(count) ? "ok" : "wrong") << std::endl;
+
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	std::cout << "  futures   threads  resume(us)    result" << std::endl;
+
+	for (auto count : { 100u, 1'000u, 10'000u })
+		bench_futures(count);
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
@@ -0,0 +1,101 @@
+//--------------------------------------------------------------------
+//	bench_latency.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Benchmarks of the timer precision of the Job Scheduler - A Part
+//		of Agave(TM) Coroutine Framework (based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+using bench_clock = std::chrono::steady_clock;
+
+
+//--------------------------------------------------------------------
+//	a pacing loop, sleeps until each tick of the period and records
+//	how late it was resumed.
+//--------------------------------------------------------------------
+agave::AsyncAction
+pace_async(std::chrono::microseconds period, std::vector<bench_clock::duration>& lateness)
+{
+	auto next = bench_clock::now() + 10ms;
+
+	for (auto& late : lateness)
+	{
+		next += period;
+		co_await next;
+		late = bench_clock::now() - next;
+	}
+
+}
+
+
+//--------------------------------------------------------------------
+static auto percentile(std::vector<bench_clock::duration> const& sorted, double p)
+{
+	auto index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1u));
+	return std::chrono::duration<double, std::micro>(sorted[index]).count();
+}
+
+
+//--------------------------------------------------------------------
+static void bench_pacing(
+	agave::BJobTimer timer,
+	agave::BJobBackend backend,
+	std::chrono::microseconds tolerance,
+	std::chrono::microseconds period)
+{
+	agave::set_job_timer(timer);
+	agave::set_job_backend(backend);
+	agave::set_job_tolerance(tolerance);
+	agave::set_job_shards(1u);
+
+	std::vector<bench_clock::duration> lateness(std::max<std::size_t>(2'000u, 1s / period));
+	pace_async(period, lateness).get();
+	std::sort(lateness.begin(), lateness.end());
+
+	std::cout << std::left << std::setw(10) << (timer == agave::BJobTimer::timerfd ? "timerfd" : "condvar")
+		<< std::setw(14) << (backend == agave::BJobBackend::list ? "list" : "timing_wheel")
+		<< std::right << std::setw(7) << tolerance / 1us
+		<< std::setw(8) << period / 1us
+		<< std::fixed << std::setprecision(1)
+		<< std::setw(10) << percentile(lateness, 0.5)
+		<< std::setw(10) << percentile(lateness, 0.99)
+		<< std::setw(10) << percentile(lateness, 0.999)
+		<< std::setw(10) << percentile(lateness, 1.0) << std::endl;
+
+	agave::details::BJobScheduler::destroy_instance();
+
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	std::cout << "timer     backend       tol(us) per(us)  p50(us)   p99(us)  p999(us)   max(us)" << std::endl;
+
+	for (auto period : { 100us, 500us })
+	{
+		for (auto timer : { agave::BJobTimer::condition_variable, agave::BJobTimer::timerfd })
+		{
+			bench_pacing(timer, agave::BJobBackend::list, 1000us, period);
+			bench_pacing(timer, agave::BJobBackend::timing_wheel, 1000us, period);
+			bench_pacing(timer, agave::BJobBackend::timing_wheel, 10us, period);
+		}
+	}
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
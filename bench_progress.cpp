@@ -0,0 +1,90 @@
+//--------------------------------------------------------------------
+//	bench_progress.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Benchmarks of progress reporting - A Part of Agave(TM)
+//		Coroutine Framework (based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <iomanip>
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+using bench_clock = std::chrono::steady_clock;
+
+
+//--------------------------------------------------------------------
+//	a tight loop reporting the percentage after every item.
+//--------------------------------------------------------------------
+agave::AsyncOperationWithProgress<long long, double>
+work_async(std::size_t count, agave::details::BDuration interval)
+{
+	co_await agave::resume_background();
+	auto controller = co_await agave::get_progress_controller();
+
+	if (interval != agave::details::BDuration::zero())
+		controller.set_rate(interval);
+
+	auto t0 = bench_clock::now();
+	for (std::size_t i = 0; i < count; ++i)
+		controller.report_progress(100.0 * i / count);
+
+	auto elapsed = bench_clock::now() - t0;
+	controller.report_progress(100.0, true);
+
+	co_return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+
+//--------------------------------------------------------------------
+//	the reporter reads on the foreground, reports the producer's cost
+//	per report and how many reports were read.
+//--------------------------------------------------------------------
+static void bench_reports(char const* name, std::size_t count, agave::details::BDuration interval)
+{
+	auto operation = work_async(count, interval);
+	std::size_t reads = 0;
+
+	[&](void) -> agave::AsyncAction
+		{
+			auto reporter = operation.get_progress_reporter();
+			while (reporter)
+			{
+				co_await reporter;
+				++reads;
+			}
+
+		}().get();
+
+	auto ns = operation.get();
+
+	std::cout << std::left << std::setw(14) << name << std::right
+		<< std::setw(12) << count
+		<< std::setw(12) << std::fixed << std::setprecision(2) << static_cast<double>(ns) / count
+		<< std::setw(10) << reads << std::endl;
+
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	std::cout << "policy              reports   ns/report     reads" << std::endl;
+
+	for (auto count : { 100'000u, 10'000'000u })
+	{
+		bench_reports("every report", count, 0ms);
+		bench_reports("every 16ms", count, 16ms);
+	}
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
@@ -0,0 +1,77 @@
+//--------------------------------------------------------------------
+//	bench_resume.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Benchmarks of resuming on the background executors - A Part of
+//		Agave(TM) Coroutine Framework (based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+using bench_clock = std::chrono::steady_clock;
+
+
+//--------------------------------------------------------------------
+agave::AsyncAction
+hop_async(std::size_t hops)
+{
+	for (std::size_t i = 0u; i < hops; ++i)
+		co_await agave::resume_background();
+}
+
+
+//--------------------------------------------------------------------
+//	runs N coroutines hopping to the background M times each.
+//--------------------------------------------------------------------
+static void bench_hops(char const* name, std::size_t coroutines, std::size_t hops)
+{
+	std::vector<agave::AsyncAction> actions;
+	actions.reserve(coroutines);
+
+	auto t0 = bench_clock::now();
+	for (std::size_t i = 0u; i < coroutines; ++i)
+		actions.push_back(hop_async(hops));
+
+	for (auto& action : actions)
+		action.get();
+
+	auto elapsed = std::chrono::duration<double>(bench_clock::now() - t0).count();
+	auto resumes = static_cast<double>(coroutines * hops);
+
+	std::cout << std::left << std::setw(18) << name
+		<< std::right << std::setw(12) << coroutines * hops
+		<< std::setw(16) << std::fixed << std::setprecision(0) << resumes / elapsed
+		<< std::endl;
+
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	std::cout << "executor               resumes      resumes/s" << std::endl;
+
+	// the previous default: a new thread for each resume.
+	agave::set_bg_entry([](std::function<void(void)> procedure)
+		{ std::thread{ procedure }.detach(); });
+	bench_hops("thread-per-resume", 100u, 100u);
+
+	// the built-in work stealing pool.
+	agave::set_bg_entry(nullptr);
+	bench_hops("thread pool", 100u, 100u);
+	bench_hops("thread pool", 1000u, 1000u);
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
@@ -0,0 +1,289 @@
+//--------------------------------------------------------------------
+//	bench_timers.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Benchmarks of the Job Scheduler backends - A Part of Agave(TM) 
+//		Coroutine Framework (based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+using bench_clock = std::chrono::steady_clock;
+
+
+//--------------------------------------------------------------------
+static char const* backend_name(agave::BJobBackend backend)
+{
+	return backend == agave::BJobBackend::list ? "list" : "timing_wheel";
+}
+
+
+//--------------------------------------------------------------------
+//	* N pending jobs are queued far in the future (in descending order,
+//	  which is the cheapest order for the list backend).
+//	* then the cost of inserting / removing a job at a random position
+//	  is measured on top of the N pending jobs, one by one and in bulk.
+//--------------------------------------------------------------------
+static void bench_insert_remove(agave::BJobBackend backend, std::size_t pending)
+{
+	agave::set_job_backend(backend);
+	auto scheduler = agave::details::BJobScheduler::instance_ptr();
+
+	auto last = bench_clock::now() + 600s;
+	for (std::size_t i = 0u; i < pending; ++i)
+		scheduler->add_job_at(last - std::chrono::microseconds(i), [] {});
+
+	constexpr std::size_t probes = 100u;
+	std::mt19937_64 rng{ 1900u };
+	std::vector<agave::BJobToken> tokens;
+	tokens.reserve(probes);
+
+	auto t0 = bench_clock::now();
+	for (std::size_t i = 0u; i < probes; ++i)
+		tokens.push_back(scheduler->add_job(
+			std::chrono::microseconds(rng() % 600'000'000u), [] {}));
+
+	auto t1 = bench_clock::now();
+	for (auto& tok : tokens)
+		scheduler->remove_job(tok);
+
+	auto t2 = bench_clock::now();
+
+	tokens.clear();
+	for (std::size_t i = 0u; i < probes; ++i)
+		tokens.push_back(scheduler->add_job(
+			std::chrono::microseconds(rng() % 600'000'000u), [] {}));
+
+	auto t3 = bench_clock::now();
+	scheduler->remove_jobs(tokens);
+	auto t4 = bench_clock::now();
+
+	std::cout << std::left << std::setw(14) << backend_name(backend)
+		<< std::right << std::setw(9) << pending
+		<< std::setw(16) << (t1 - t0) / 1ns / probes
+		<< std::setw(16) << (t2 - t1) / 1ns / probes
+		<< std::setw(16) << (t4 - t3) / 1ns / probes << std::endl;
+
+	scheduler = nullptr;
+	agave::details::BJobScheduler::destroy_instance();
+
+}
+
+
+//--------------------------------------------------------------------
+//	N jobs expire within the same 200ms window, measures how long the
+//	scheduler lags behind the last deadline until all of them fired.
+//--------------------------------------------------------------------
+static void bench_expiry(agave::BJobBackend backend, std::size_t pending)
+{
+	agave::set_job_backend(backend);
+	auto scheduler = agave::details::BJobScheduler::instance_ptr();
+
+	std::atomic<std::size_t> fired{ 0u };
+	auto window = std::chrono::duration_cast<std::chrono::nanoseconds>(200ms);
+	auto start = bench_clock::now() + 2s;
+
+	for (std::size_t i = 0u; i < pending; ++i)
+	{
+		auto tp = start + window - window * i / pending;
+		scheduler->add_job_at(tp,
+			[&fired] { fired.fetch_add(1u, std::memory_order::relaxed); });
+	}
+
+	while (fired.load(std::memory_order::relaxed) < pending)
+		std::this_thread::sleep_for(100us);
+
+	auto lag = bench_clock::now() - (start + window);
+
+	std::cout << std::left << std::setw(14) << backend_name(backend)
+		<< std::right << std::setw(9) << pending
+		<< std::setw(16) << lag / 1us << std::endl;
+
+	scheduler = nullptr;
+	agave::details::BJobScheduler::destroy_instance();
+
+}
+
+
+//--------------------------------------------------------------------
+//	N jobs expire 1ns apart (in descending order, as
+//	above) and run on the thread pool, measures how long it takes from
+//	the last deadline until all of them ran.
+//--------------------------------------------------------------------
+static void bench_burst(agave::BJobBackend backend, std::size_t pending)
+{
+	agave::set_job_backend(backend);
+	agave::set_job_shards(1u);
+	auto scheduler = agave::details::BJobScheduler::instance_ptr();
+
+	std::atomic<std::size_t> fired{ 0u };
+	auto tp = bench_clock::now() + 500ms;
+
+	for (std::size_t i = 0u; i < pending; ++i)
+		scheduler->add_job_at(tp - std::chrono::nanoseconds(i),
+			[&fired] { fired.fetch_add(1u, std::memory_order::relaxed); });
+
+	while (fired.load(std::memory_order::relaxed) < pending)
+		std::this_thread::sleep_for(50us);
+
+	auto drain = bench_clock::now() - tp;
+
+	std::cout << std::left << std::setw(14) << backend_name(backend)
+		<< std::right << std::setw(9) << pending
+		<< std::setw(14) << drain / 1us << std::endl;
+
+	scheduler = nullptr;
+	agave::details::BJobScheduler::destroy_instance();
+	agave::set_job_shards(0u);
+
+}
+
+
+//--------------------------------------------------------------------
+//	T threads insert and cancel jobs concurrently, each job is removed
+//	right after it was added, reports the total throughput.
+//--------------------------------------------------------------------
+static void bench_concurrent(unsigned shards, unsigned threads)
+{
+	constexpr std::size_t pairs = 200'000u;
+
+	agave::set_job_backend(agave::BJobBackend::timing_wheel);
+	agave::set_job_shards(shards);
+	auto scheduler = agave::details::BJobScheduler::instance_ptr();
+
+	std::vector<std::thread> workers;
+	auto t0 = bench_clock::now();
+
+	for (auto t = 0u; t < threads; ++t)
+	{
+		workers.emplace_back([&scheduler, t]
+			{
+				std::mt19937_64 rng{ 1900u + t };
+				for (std::size_t i = 0u; i < pairs; ++i)
+				{
+					auto tok = scheduler->add_job(
+						std::chrono::microseconds(rng() % 600'000'000u), [] {});
+					scheduler->remove_job(tok);
+				}
+			});
+	}
+
+	for (auto& worker : workers)
+		worker.join();
+
+	auto elapsed = std::chrono::duration<double>(bench_clock::now() - t0).count();
+
+	std::cout << std::right << std::setw(6) << shards
+		<< std::setw(9) << threads
+		<< std::setw(16) << std::fixed << std::setprecision(2)
+		<< static_cast<double>(pairs * threads) / elapsed / 1e6 << std::endl;
+
+	scheduler = nullptr;
+	agave::details::BJobScheduler::destroy_instance();
+	agave::set_job_shards(0u);
+
+}
+
+
+//--------------------------------------------------------------------
+//	N jobs with deadlines spread evenly over 1s and the same slack,
+//	reports how often the expiry thread woke up within the second, and
+//	the latest job.
+//--------------------------------------------------------------------
+static void bench_slack(agave::BJobBackend backend, std::size_t pending, std::chrono::microseconds slack)
+{
+	agave::set_job_backend(backend);
+	agave::set_job_shards(1u);
+	auto scheduler = agave::details::BJobScheduler::instance_ptr();
+
+	std::atomic<std::size_t> fired{ 0u };
+	std::vector<bench_clock::duration> lateness(pending);
+	auto window = std::chrono::duration_cast<std::chrono::nanoseconds>(1s);
+	auto start = bench_clock::now() + 200ms;
+	auto wakeups = scheduler->wakeups();
+
+	for (std::size_t i = 0u; i < pending; ++i)
+	{
+		auto tp = start + window * i / pending;
+		scheduler->add_job_at(tp, [&fired, &lateness, i, tp]
+			{
+				lateness[i] = bench_clock::now() - tp;
+				fired.fetch_add(1u, std::memory_order::release);
+			}, slack);
+	}
+
+	while (fired.load(std::memory_order::acquire) < pending)
+		std::this_thread::sleep_for(1ms);
+
+	wakeups = scheduler->wakeups() - wakeups;
+
+	std::cout << std::left << std::setw(14) << backend_name(backend)
+		<< std::right << std::setw(9) << pending
+		<< std::setw(10) << slack / 1us
+		<< std::setw(12) << wakeups
+		<< std::setw(14) << std::chrono::duration_cast<std::chrono::microseconds>(
+			*std::max_element(lateness.begin(), lateness.end())).count() << std::endl;
+
+	scheduler = nullptr;
+	agave::details::BJobScheduler::destroy_instance();
+	agave::set_job_shards(0u);
+
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	// run the expired jobs on the scheduler thread itself.
+	agave::set_job_entry([](std::function<void(void)> procedure) { procedure(); });
+
+	std::size_t const sizes[] = { 1'000u, 100'000u, 1'000'000u };
+	agave::BJobBackend const backends[] = { agave::BJobBackend::list, agave::BJobBackend::timing_wheel };
+
+	std::cout << "backend         pending   insert(ns/op)   remove(ns/op)     bulk(ns/op)" << std::endl;
+	for (auto backend : backends)
+		for (auto size : sizes)
+			bench_insert_remove(backend, size);
+
+	std::cout << std::endl << "backend         pending  drain lag(us)" << std::endl;
+	for (auto backend : backends)
+		for (auto size : sizes)
+			bench_expiry(backend, size);
+
+	std::cout << std::endl << "backend         pending  slack(us)  wakeups/s  max late(us)" << std::endl;
+	for (auto backend : backends)
+		for (auto slack : { 0us, 1000us, 10'000us, 50'000us })
+			bench_slack(backend, 10'000u, slack);
+
+	// the bursts run on the default executor, the thread pool.
+	agave::set_job_entry(nullptr);
+	std::cout << std::endl << "backend         pending    drain(us)" << std::endl;
+	for (auto backend : backends)
+		for (auto size : { 10'000u, 100'000u })
+			bench_burst(backend, size);
+
+	auto cores = std::max(1u, std::thread::hardware_concurrency());
+	std::cout << std::endl << "shards  threads  add+remove(M/s)   [" << cores << " hardware threads]" << std::endl;
+	for (auto threads : { 1u, 2u, 4u, 8u })
+	{
+		bench_concurrent(1u, threads);
+		bench_concurrent(threads, threads);
+	}
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
@@ -25,6 +25,9 @@ do_work_async(void)
 	co_await agave::resume_background();
 	auto controller = co_await agave::get_progress_controller();
 
+	// keep every report, stall here if the reporter falls 16 behind.
+	controller.set_policy(agave::ProgressPolicy::block, 16);
+
 	for (int i = 0; i < 100; ++i)
 	{
 		controller.report_progress(i);
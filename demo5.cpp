@@ -0,0 +1,75 @@
+//--------------------------------------------------------------------
+//	demo5.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Demonstrations of Agave(TM) Coroutine Framework 
+//		(based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+fetch_async(int seconds)
+{
+	auto token = co_await agave::get_cancellation_token();
+	co_await std::chrono::seconds(seconds);
+
+	if (token) // the losers of when_any are canceled.
+	{
+		std::cout << "* fetch " << seconds << "s canceled!" << std::endl;
+		co_return -1;
+	}
+
+	std::cout << "* fetch " << seconds << "s finished!" << std::endl;
+	co_return seconds * 100;
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncAction
+notify_async(void)
+{
+	co_await 2s;
+	std::cout << "* notified!" << std::endl;
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncAction
+foo(void)
+{
+	std::cout << "VVV - when_all - VVV" << std::endl;
+	auto [a, b, _] = co_await agave::when_all(fetch_async(1), fetch_async(3), notify_async());
+	std::cout << "* results: " << a << ", " << b << std::endl;
+
+	std::cout << std::endl << "VVV - when_any - VVV" << std::endl;
+	std::vector<agave::AsyncOperation<int>> fetches;
+	for (int i = 3; i >= 1; --i)
+		fetches.push_back(fetch_async(i));
+
+	auto index = co_await agave::when_any(fetches);
+	std::cout << "* winner: " << index << ", result: " << fetches[index].get() << std::endl;
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	foo().get();
+	std::this_thread::sleep_for(100ms);
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
@@ -0,0 +1,59 @@
+//--------------------------------------------------------------------
+//	demo6.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Demonstrations of Agave(TM) Coroutine Framework 
+//		(based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<std::size_t>
+count_words_async(agave::ThreadPool& cpu_pool, agave::ThreadPool& io_pool, char const* path)
+{
+	// the blocking read goes to the io pool...
+	co_await agave::resume_on(io_pool);
+	std::cout << "* reading on " << std::this_thread::get_id() << std::endl;
+
+	std::ifstream file{ path };
+	std::stringstream text;
+	text << file.rdbuf();
+
+	// ...the counting to the cpu pool.
+	co_await agave::resume_on(cpu_pool);
+	std::cout << "* counting on " << std::this_thread::get_id() << std::endl;
+
+	std::size_t count = 0u;
+	for (std::string word; text >> word; )
+		++count;
+
+	co_return count;
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	auto cpu_pool = agave::make_thread_pool(std::thread::hardware_concurrency());
+	auto io_pool = agave::make_thread_pool(2u);
+
+	auto count = count_words_async(*cpu_pool, *io_pool, "demo6.cpp").get();
+	std::cout << "* words: " << count << std::endl;
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
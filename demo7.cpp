@@ -0,0 +1,57 @@
+//--------------------------------------------------------------------
+//	demo7.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Demonstrations of Agave(TM) Coroutine Framework 
+//		(based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+download_async(int id)
+{
+	co_await agave::resume_background();
+	co_await std::chrono::milliseconds(100 * id);	// the slow part, in the background.
+
+	co_await agave::resume_foreground();	// back to the main thread.
+	std::cout << "* download " << id << " finished on the main thread." << std::endl;
+
+	co_return id * 10;
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+foo(void)
+{
+	auto [a, b, c] = co_await agave::when_all(download_async(1), download_async(2), download_async(3));
+	co_return a + b + c;
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	// the main thread runs the foreground continuations.
+	agave::RunLoop loop;
+	agave::set_fg_executor(loop);
+
+	auto sum = loop.run_until(foo());
+	std::cout << "* sum: " << sum << std::endl;
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
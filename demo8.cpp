@@ -0,0 +1,75 @@
+//--------------------------------------------------------------------
+//	demo8.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Demonstrations of Agave(TM) Coroutine Framework 
+//		(based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <map>
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+
+
+//--------------------------------------------------------------------
+agave::AsyncEvent start;				// opens the gate for all the requests.
+agave::AsyncSemaphore backend{ 4 };		// at most 4 requests in flight.
+agave::AsyncMutex results_mx;			// guards 'results' across the awaits.
+std::map<int, int> results;
+
+
+//--------------------------------------------------------------------
+agave::AsyncAction
+request_async(int id, agave::AsyncLatch& done)
+{
+	co_await agave::resume_background();
+	co_await start.wait();
+
+	// the coroutine is suspended while waiting, not the pool thread.
+	co_await backend.acquire();
+	co_await 50ms;	// the backend call.
+	backend.release();
+
+	{
+		auto guard = co_await results_mx.lock();
+		results[id] = id * id;
+	}
+
+	done.count_down();
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	agave::AsyncLatch done{ 16 };
+
+	std::vector<agave::AsyncAction> requests;
+	for (int i = 0; i < 16; ++i)
+		requests.push_back(request_async(i, done));
+
+	auto t0 = std::chrono::steady_clock::now();
+	start.set();
+
+	[&](void) -> agave::AsyncAction
+		{
+			co_await done.wait();
+
+			auto guard = co_await results_mx.lock();
+			std::cout << "* " << results.size() << " results in "
+				<< (std::chrono::steady_clock::now() - t0) / 1ms << "ms (4 rounds of 50ms)." << std::endl;
+
+		}().get();
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
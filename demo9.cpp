@@ -0,0 +1,140 @@
+//--------------------------------------------------------------------
+//	demo9.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Demonstrations of Agave(TM) Coroutine Framework 
+//		(based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <cstring>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <stdlib.h>
+#endif
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+
+
+//--------------------------------------------------------------------
+constexpr std::size_t chunk_size = 64 * 1024;
+constexpr std::size_t chunk_count = 16;
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+write_chunk_async(int fd, std::span<std::byte const> chunk, std::size_t index)
+{
+	co_return co_await agave::io::write(fd, chunk, index * chunk_size);
+}
+
+
+//--------------------------------------------------------------------
+//	reads into the registered buffer 0, at the slice of the chunk.
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+read_chunk_async(int fd, std::span<std::byte> slice, std::size_t index)
+{
+	co_return co_await agave::io::read_fixed(fd, slice, index * chunk_size, 0u);
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+read_pipe_async(int fd)
+{
+	std::byte buf[16];
+	co_return co_await agave::io::read(fd, buf, ~0ull);
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+#if defined(__linux__)
+	if (!agave::io::is_available())
+	{
+		std::cout << "* io_uring is not available." << std::endl;
+		return 0;
+	}
+
+	char path[] = "/tmp/agave_demo9_XXXXXX";
+	auto fd = ::mkstemp(path);
+
+	std::vector<std::byte> data(chunk_size * chunk_count);
+	for (std::size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<std::byte>(i * 31u + 7u);
+
+	// all of the writes go to the kernel by one system call.
+	std::vector<agave::AsyncOperation<int>> writes;
+	{
+		agave::io::SubmitBatch batch;
+		for (std::size_t i = 0; i < chunk_count; ++i)
+			writes.push_back(write_chunk_async(fd, std::span(data).subspan(i * chunk_size, chunk_size), i));
+	}
+
+	std::size_t written = 0;
+	for (auto& write : writes)
+		written += write.get();
+
+	auto synced = [&](void) -> agave::AsyncOperation<int>
+		{
+			co_return co_await agave::io::fsync(fd);
+		}().get();
+
+	std::cout << "* wrote " << written << " bytes by " << chunk_count
+		<< " writes, fsync " << (synced == 0 ? "ok." : "failed.") << std::endl;
+
+	// read back into one registered buffer, pinned once for all the reads.
+	std::vector<std::byte> buffer(data.size());
+	std::span<std::byte> buffers[]{ buffer };
+	agave::io::register_buffers(buffers);
+
+	std::vector<agave::AsyncOperation<int>> reads;
+	{
+		agave::io::SubmitBatch batch;
+		for (std::size_t i = 0; i < chunk_count; ++i)
+			reads.push_back(read_chunk_async(fd, std::span(buffer).subspan(i * chunk_size, chunk_size), i));
+	}
+
+	std::size_t read = 0;
+	for (auto& chunk : reads)
+		read += chunk.get();
+
+	agave::io::unregister_buffers();
+
+	std::cout << "* read " << read << " bytes, "
+		<< (std::memcmp(buffer.data(), data.data(), data.size()) ? "mismatched." : "matched.") << std::endl;
+
+	// a read which never completes, until canceled.
+	int pipe_fds[2];
+	if (::pipe(pipe_fds) == 0)
+	{
+		auto pending = read_pipe_async(pipe_fds[0]);
+		std::this_thread::sleep_for(10ms);
+		pending.cancel();
+
+		std::cout << "* canceled pipe read: " << std::strerror(-pending.get()) << "." << std::endl;
+
+		::close(pipe_fds[0]);
+		::close(pipe_fds[1]);
+	}
+
+	::close(fd);
+	::unlink(path);
+#else
+	std::cout << "* agave::io needs the io_uring of Linux." << std::endl;
+#endif
+
+	return 0;
+}
+
+
+//--------------------------------------------------------------------
@@ -0,0 +1,273 @@
+//--------------------------------------------------------------------
+//	test_cancel.cpp.
+//	10/17/2026.				created.
+//	10/17/2026.				last modified.
+//--------------------------------------------------------------------
+//	*	Tests of cancellation - A Part of Agave(TM)
+//		Coroutine Framework (based on ISO C++20 or later).
+//	*	if has any questions, 
+//	*	please contact me at 'full1900@outlook.com'.
+//	*	by bubo.
+//--------------------------------------------------------------------
+#include "Agave.hpp"
+#include <iostream>
+#include <future>
+#include <cerrno>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+
+//--------------------------------------------------------------------
+using namespace std::chrono_literals;
+using test_clock = std::chrono::steady_clock;
+
+
+//--------------------------------------------------------------------
+static int __failures = 0;
+
+static void check(bool is_ok, char const* name)
+{
+	std::cout << (is_ok ? "[ ok ] " : "[fail] ") << name << std::endl;
+	if (!is_ok)
+		++__failures;
+}
+
+
+//--------------------------------------------------------------------
+//	sleeps only once 'go' is set, which is after the cancellation.
+//--------------------------------------------------------------------
+agave::AsyncAction
+sleep_after_async(std::atomic<bool>& go, test_clock::duration& slept)
+{
+	co_await agave::resume_background();
+	while (!go.load())
+		std::this_thread::yield();
+
+	auto t0 = test_clock::now();
+	co_await 10s;
+	slept = test_clock::now() - t0;
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncAction
+sleep_async(void)
+{
+	co_await agave::resume_background();
+	co_await 10s;
+}
+
+
+//--------------------------------------------------------------------
+//	a sleep awaited after the cancellation does not suspend.
+//--------------------------------------------------------------------
+static void test_canceled_then_sleep(void)
+{
+	std::atomic<bool> go{ false };
+	auto slept = test_clock::duration::max();
+
+	auto action = sleep_after_async(go, slept);
+	action.cancel();
+	go.store(true);
+	action.get();
+
+	check(slept < 1s, "canceled, then co_await 10s resumes at once");
+}
+
+
+//--------------------------------------------------------------------
+//	the cancellation races with the suspension of the sleep, neither
+//	side may miss the other.
+//--------------------------------------------------------------------
+static void test_cancel_during_suspend(void)
+{
+	auto t0 = test_clock::now();
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		auto action = sleep_async();
+		if (i % 2)
+			std::this_thread::yield();
+
+		action.cancel();
+		action.get();
+	}
+
+	check(test_clock::now() - t0 < 5s, "cancel racing co_await 10s, 1000 times");
+}
+
+
+//--------------------------------------------------------------------
+//	a sleep pending in the scheduler is removed by the cancellation.
+//--------------------------------------------------------------------
+static void test_cancel_pending_sleep(void)
+{
+	auto t0 = test_clock::now();
+
+	auto action = sleep_async();
+	std::this_thread::sleep_for(20ms);
+	action.cancel();
+	action.get();
+
+	check(test_clock::now() - t0 < 1s, "cancel a pending co_await 10s");
+}
+
+
+//--------------------------------------------------------------------
+//	the sleeper of a deadline, as the one of with_deadline(), which
+//	counts when it is done.
+//--------------------------------------------------------------------
+agave::details::async_action_base_t<>
+count_sleeper_async(agave::details::BTimePoint tp, std::atomic<int>& done)
+{
+	co_await agave::resume_background();
+	co_await tp;
+	++done;
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+quick_async(void)
+{
+	co_await agave::resume_background();
+	co_return 1;
+}
+
+
+//--------------------------------------------------------------------
+//	the operation wins, mostly before the sleep of the deadline is
+//	linked, the sleeper must not outlive it by the whole timeout.
+//--------------------------------------------------------------------
+static void test_timeout_releases_sleeper(void)
+{
+	constexpr int count = 200;
+	std::atomic<int> done{ 0 };
+	int won = 0;
+
+	[&](void) -> agave::AsyncAction
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				auto op = quick_async();
+				auto result = co_await agave::details::timeout_awaiter_t<agave::AsyncOperation<int>>{
+					op, count_sleeper_async(agave::details::BClock::now() + 10s, done) };
+
+				if (result)
+					++won;
+			}
+
+		}().get();
+
+	auto t0 = test_clock::now();
+	while (done.load() < count && test_clock::now() - t0 < 2s)
+		std::this_thread::sleep_for(1ms);
+
+	check(won == count && done.load() == count, "with_timeout(op, 10s), the sleepers finish with op");
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+await_future_async(std::future<int> future)
+{
+	co_await agave::resume_background();
+	co_return co_await std::move(future);
+}
+
+
+//--------------------------------------------------------------------
+//	a future never ready is not waited for once canceled.
+//--------------------------------------------------------------------
+static void test_cancel_future(void)
+{
+	std::promise<int> promise;
+	auto t0 = test_clock::now();
+
+	auto op = await_future_async(promise.get_future());
+	std::this_thread::sleep_for(20ms);
+	op.cancel();
+
+	auto result = op.get();
+
+	check(result == 0 && test_clock::now() - t0 < 1s, "cancel co_await of a future never ready");
+}
+
+
+//--------------------------------------------------------------------
+//	with_timeout() abandons the operation waiting for a future, which
+//	then finishes as well.
+//--------------------------------------------------------------------
+static void test_timeout_future(void)
+{
+	std::promise<int> promise;
+	auto t0 = test_clock::now();
+	auto is_timeout = false;
+
+	auto op = await_future_async(promise.get_future());
+	[&](void) -> agave::AsyncAction
+		{
+			auto result = co_await agave::with_timeout(op, 20ms);
+			is_timeout = !result;
+
+		}().get();
+
+	op.get();
+
+	check(is_timeout && test_clock::now() - t0 < 1s, "with_timeout(co_await future, 20ms), the waiter finishes");
+}
+
+
+//--------------------------------------------------------------------
+agave::AsyncOperation<int>
+read_async(int fd)
+{
+	std::byte buf[16];
+	co_return co_await agave::io::read(fd, buf, ~0ull);
+}
+
+
+//--------------------------------------------------------------------
+//	the reactor going away cancels a read never ready, rather than
+//	dropping it.
+//--------------------------------------------------------------------
+static void test_destroy_io_reactor(void)
+{
+#if defined(__linux__)
+	int fds[2];
+	if (!agave::io::is_available() || ::pipe(fds))
+		return;
+
+	auto t0 = test_clock::now();
+
+	auto op = read_async(fds[0]);
+	std::this_thread::sleep_for(20ms);
+	agave::details::BIoReactor::destroy_instance();
+
+	auto result = op.get();
+
+	::close(fds[0]);
+	::close(fds[1]);
+
+	check(result == -ECANCELED && test_clock::now() - t0 < 1s, "destroy the io reactor with a read in flight");
+#endif
+}
+
+
+//--------------------------------------------------------------------
+int main(void)
+{
+	test_canceled_then_sleep();
+	test_cancel_during_suspend();
+	test_cancel_pending_sleep();
+	test_timeout_releases_sleeper();
+	test_cancel_future();
+	test_timeout_future();
+	test_destroy_io_reactor();
+
+	return __failures ? 1 : 0;
+}
+
+
+//--------------------------------------------------------------------